@@ -55,10 +55,19 @@
 #pragma once
 
 #include <new>
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <memory>
+#include <limits>
 #include <string>
 #include <numeric>
+#include <stdexcept>
+#include <system_error>
 #include <utility>
 #include <assert.h>
 #include <type_traits>
@@ -91,10 +100,40 @@
 #include <intrin.h>
 #endif
 
+#if defined(__SIZEOF_INT128__)
+#define STRINGBUILDER_SUPPORTS_INT128
+#endif
+
+#if defined(__has_include) && __has_include(<memory_resource>)
+#include <memory_resource>
+#endif
+#if __cpp_lib_memory_resource
+#define STRINGBUILDER_SUPPORTS_PMR
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <errno.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#define STRINGBUILDER_SUPPORTS_MMAP
+#define STRINGBUILDER_SUPPORTS_IOVEC
+#endif
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_M_IX86) || defined(_M_X64) || defined(_M_ARM64)
+#define STRINGBUILDER_LITTLE_ENDIAN
+#endif
+
 namespace STRINGBUILDER_NAMESPACE
 {
     namespace detail
     {
+#ifdef STRINGBUILDER_SUPPORTS_INT128
+        __extension__ typedef __int128 Int128;
+        __extension__ typedef unsigned __int128 UInt128;
+#endif
+
         inline void prefetchWrite(const void* p)
         {
 #if defined(__GNUC__)
@@ -103,6 +142,39 @@ namespace STRINGBUILDER_NAMESPACE
             _mm_prefetch((const char*)p, _MM_HINT_T0);
 #endif
         }
+
+#ifdef STRINGBUILDER_SUPPORTS_IOVEC
+#ifdef IOV_MAX
+        constexpr size_t iovBatchSize = IOV_MAX < 1024 ? IOV_MAX : 1024;
+#else
+        constexpr size_t iovBatchSize = 16;  // _XOPEN_IOV_MAX, the least every POSIX system accepts.
+#endif
+
+        /// Writes all the `count` iovec structures to the file descriptor, calling writev() again after a partial write or EINTR. The structures are altered on the way.
+        /// Returns 0 on success or the errno of the failed writev(). Either way, `written` is increased by the number of bytes written.
+        inline int writevFully(int fd, struct iovec* iov, size_t count, size_t& written) noexcept
+        {
+            while (count > 0) {
+                const ssize_t result = ::writev(fd, iov, static_cast<int>(count));
+                if (result < 0) {
+                    if (errno == EINTR)
+                        continue;
+                    return errno;
+                }
+
+                auto left = static_cast<size_t>(result);
+                written += left;
+                for (; count > 0 && left >= iov->iov_len; ++iov, --count) {
+                    left -= iov->iov_len;
+                }
+                if (count > 0) {
+                    iov->iov_base = static_cast<char*>(iov->iov_base) + left;
+                    iov->iov_len -= left;
+                }
+            }
+            return 0;
+        }
+#endif
     }
 
     template<size_t ExpectedSize, typename StringT>
@@ -150,6 +222,21 @@ namespace STRINGBUILDER_NAMESPACE
         }
     };
 
+    // Range appender is the counterpart of the appender for a whole range of objects, which are separated with a given string.
+    // Unless there are suitable converters, the objects are appended one by one.
+    template<typename SB, typename T, typename Enable = void>
+    struct sb_range_appender {
+        template<typename ForwardIt>
+        void operator()(SB& sb, ForwardIt first, ForwardIt last, const typename SB::char_type* separator, size_t separatorSize) const {
+            for (auto it = first; it != last; ++it) {
+                if (it != first) {
+                    sb.append(separator, separatorSize);
+                }
+                sb.append(*it);
+            }
+        }
+    };
+
 
     /// Compile-time switch which controls the behaiovr of inplace_stringbuilder upon buffer overflow.
     ///
@@ -208,6 +295,8 @@ namespace STRINGBUILDER_NAMESPACE
         /// Indicates whether the append*() function calls may throw.
         /// This may happen upon character buffer overflow when the overflow policy is set to either early_exception or late_exception.
         static constexpr bool append_may_not_throw = overflow_policy != inplace_stringbuilder_overflow_polcy::early_exception && overflow_policy != inplace_stringbuilder_overflow_polcy::late_exception;
+        /// Indicates whether claim() may refuse to claim the characters (by returning nullptr) rather than overflow.
+        static constexpr bool claim_may_refuse = overflow_policy == inplace_stringbuilder_overflow_polcy::protect || overflow_policy == inplace_stringbuilder_overflow_polcy::late_exception;
 
         /// Gets the number of characters appended to the buffer.
         size_type size() const noexcept { return consumed; }
@@ -354,6 +443,33 @@ namespace STRINGBUILDER_NAMESPACE
             return *this;
         }
 
+        /// Claims exactly the specified number of characters at the end of the content and returns the pointer to the first of them.
+        /// The caller is obliged to fill all of the claimed characters in forward order, regardless of the direction of the builder.
+        /// Under protect and late_exception overflow policies a claim which does not fit is refused by returning nullptr, leaving the content unaltered.
+        char_type* claim(size_type size)
+            //noexcept(append_may_not_throw)
+        {
+            switch (overflow_policy) {
+                case inplace_stringbuilder_overflow_polcy::assert:
+                    assert(consumed + size <= MaxSize);
+                    break;
+                case inplace_stringbuilder_overflow_polcy::corrupt_memory:
+                    break;
+                case inplace_stringbuilder_overflow_polcy::early_exception:
+                    if (consumed + size > MaxSize)
+                        throw inplace_stringbuilder_early_overflow_error{};
+                    break;
+                case inplace_stringbuilder_overflow_polcy::late_exception:
+                case inplace_stringbuilder_overflow_polcy::protect:
+                    if (consumed + size > MaxSize)
+                        return nullptr;
+                    break;
+            }
+
+            consumed += size;
+            return data_.data() + (Forward ? consumed - size : MaxSize - consumed);
+        }
+
         /// Appends the specified number of characters of a given C-style string.
         /// It is up to the user to ensure that the specified sized string is valid.
         basic_inplace_stringbuilder& append_c_str(const char_type* str, size_type size)
@@ -494,6 +610,20 @@ namespace STRINGBUILDER_NAMESPACE
             }
         }
 
+        /// Appends the content to the target string, which grows only if its capacity is insufficient.
+        template<typename OtherTraits, typename OtherAlloc>
+        void append_to(std::basic_string<char_type, OtherTraits, OtherAlloc>& target) const
+        {
+            target.append(data(), size());
+        }
+
+        /// Replaces the target string with the content, reusing the capacity of the target instead of allocating a new string like str().
+        template<typename OtherTraits, typename OtherAlloc>
+        void assign_to(std::basic_string<char_type, OtherTraits, OtherAlloc>& target) const
+        {
+            target.assign(data(), size());
+        }
+
 #if STRINGBUILDER_USES_STRING_VIEW
         /// Returns a string_view spanning over all appended characters.
         /// The retrieved string is not null-terminated.
@@ -503,6 +633,30 @@ namespace STRINGBUILDER_NAMESPACE
         }
 #endif
 
+#ifdef STRINGBUILDER_SUPPORTS_IOVEC
+        /// Writes the content to the file descriptor, resuming after partial writes and EINTR. Throws std::system_error if writing fails.
+        /// With `consume`, the characters written are removed from the builder, also when an error (e.g. EAGAIN) interrupts the writing.
+        void write_to(int fd, bool consume = false)
+        {
+            struct iovec iov;
+            iov.iov_base = data();
+            iov.iov_len = size() * sizeof(char_type);
+            size_t written = 0;
+            const int error = detail::writevFully(fd, &iov, 1, written);
+
+            if (consume) {
+                const size_type writtenChars = written / sizeof(char_type);
+                // A backward builder keeps the content at the end of the buffer, so dropping its front just shortens it.
+                if (Forward) {
+                    Traits::move(data_.data(), data_.data() + writtenChars, consumed - writtenChars);
+                }
+                consumed -= writtenChars;
+            }
+            if (error != 0)
+                throw std::system_error{error, std::generic_category(), "writev"};
+        }
+#endif
+
         /// Prints the content to the output stream.
         template<typename OtherCharTraitsT>
         friend std::basic_ostream<char_type, OtherCharTraitsT>& operator<<(
@@ -528,6 +682,12 @@ namespace STRINGBUILDER_NAMESPACE
     };
 
 
+    /// Tells whether the allocator takes its memory from an arena which is freed all at once, so that the chunks of a builder need not be deallocated one by one.
+    /// It may be specialized for custom allocators.
+    template<typename Alloc>
+    struct is_arena_allocator : std::false_type {};
+
+
     namespace detail
     {
         // The following code is based on Empty Base Optimization Helper (ebo_helper) explained in this talk:
@@ -549,7 +709,7 @@ namespace STRINGBUILDER_NAMESPACE
         {
             using AllocRebound = typename std::allocator_traits<OrigAlloc>::template rebind_alloc<uint8_t>;
 
-            template<typename OtherAlloc> constexpr explicit raw_alloc_provider(OtherAlloc&& otherAlloc) : AllocRebound{ std::forward<AllocRebound>(otherAlloc) } {}
+            template<typename OtherAlloc> constexpr explicit raw_alloc_provider(OtherAlloc&& otherAlloc) : AllocRebound{ std::forward<OtherAlloc>(otherAlloc) } {}
             AllocRebound& get_rebound_allocator() { return *this; }
             OrigAlloc get_original_allocator() const { return OrigAlloc{ *this }; }
         };
@@ -559,7 +719,7 @@ namespace STRINGBUILDER_NAMESPACE
         {
             using AllocRebound = typename std::allocator_traits<OrigAlloc>::template rebind_alloc<uint8_t>;
 
-            template<typename OtherAlloc> constexpr explicit raw_alloc_provider(OtherAlloc&& otherAlloc) : alloc_rebound{ std::forward<AllocRebound>(otherAlloc) } {}
+            template<typename OtherAlloc> constexpr explicit raw_alloc_provider(OtherAlloc&& otherAlloc) : alloc_rebound{ std::forward<OtherAlloc>(otherAlloc) } {}
             AllocRebound& get_rebound_allocator() { return alloc_rebound; }
             OrigAlloc get_original_allocator() const { return OrigAlloc{ alloc_rebound }; }
 
@@ -567,6 +727,16 @@ namespace STRINGBUILDER_NAMESPACE
             mutable AllocRebound alloc_rebound;
         };
 
+        /// Tells whether all the instances of the allocator compare equal, so that memory allocated by one can be freed by another.
+        template<typename Alloc>
+        struct IsAllocatorAlwaysEqual :
+#if __cpp_lib_allocator_traits_is_always_equal
+            std::allocator_traits<Alloc>::is_always_equal
+#else
+            std::is_empty<Alloc>
+#endif
+        {};
+
 
         template<typename CharT>
         struct Chunk;
@@ -603,16 +773,66 @@ namespace STRINGBUILDER_NAMESPACE
     }
 
 
+    // Growth policies decide how many characters the next chunk of basic_stringbuilder reserves, once the space of the tail chunk is exhausted.
+    // next_chunk_size() is given the number of characters appended so far, the number of characters reserved by the tail chunk
+    // and the minimum number of characters the next chunk must hold. The size of the whole chunk (along with its header) is then
+    // rounded up to a multiple of `granularity` bytes.
+
+    /// Each chunk is Numerator/Denominator times larger than the previous one, but not larger than MaxChunkSize characters (unless a single claim needs more).
+    /// The default geometric_growth<> doubles the chunks without a cap.
+    template<size_t Numerator = 2, size_t Denominator = 1, size_t MaxChunkSize = std::numeric_limits<size_t>::max()>
+    struct geometric_growth
+    {
+        static_assert(Numerator >= Denominator && Denominator > 0, "The growth factor must not be less than 1");
+
+        static constexpr size_t granularity = 64;  // The size of L1 data cache line (std::hardware_destructive_interference_size).
+
+        size_t next_chunk_size(size_t /*size*/, size_t tailReserved, size_t minimum) const noexcept
+        {
+            return std::max(std::min(tailReserved / Denominator * Numerator, MaxChunkSize), minimum);
+        }
+    };
+
+    /// Chunks of PageSize bytes (header included), e.g. page_growth<4096> or page_growth<64 * 1024>, or of a multiple of it if a single claim needs more.
+    /// The chunks do not grow, so huge builders waste less than a page, and every chunk spans whole pages (if the allocator aligns them to pages).
+    template<size_t PageSize>
+    struct page_growth
+    {
+        static constexpr size_t granularity = PageSize;
+
+        size_t next_chunk_size(size_t /*size*/, size_t /*tailReserved*/, size_t minimum) const noexcept { return minimum; }
+    };
+
+    /// The next chunk holds all the rest of the content expected with expect(), and past the expected size the chunks double like with geometric_growth<>.
+    /// Unlike reserve(), the hint allocates nothing up front, so the content which fits the in-place storage does not touch the heap at all.
+    struct hinted_growth
+    {
+        static constexpr size_t granularity = 64;
+
+        void expect(size_t expectedSize) noexcept { expected_size = expectedSize; }
+
+        size_t next_chunk_size(size_t size, size_t tailReserved, size_t minimum) const noexcept
+        {
+            return std::max(expected_size > size ? expected_size - size : 2 * tailReserved, minimum);
+        }
+
+        size_t expected_size = 0;
+    };
+
+
     /// Provides means for efficient construction of strings.
     /// Object of this class occupies fixed size (specified at compile-time) and allows appending portions of strings.
-    /// If the available space gets exhausted, new chunks of memory are allocated on the heap.
+    /// If the available space gets exhausted, new chunks of memory are allocated on the heap, sized according to GrowthPolicy.
     ///
     template<typename Char,
         size_t InPlaceSize,
         typename Traits,
-        typename AllocOrig>
-        class basic_stringbuilder : private detail::raw_alloc_provider<AllocOrig>
+        typename AllocOrig,
+        typename GrowthPolicy = geometric_growth<>>
+        class basic_stringbuilder : private detail::raw_alloc_provider<AllocOrig>, private GrowthPolicy
     {
+        static_assert(GrowthPolicy::granularity >= sizeof(Char), "The chunk size granularity must not be less than the size of a character");
+
         using AllocProvider = detail::raw_alloc_provider<AllocOrig>;
         using Alloc = typename AllocProvider::AllocRebound;
         using AllocTraits = std::allocator_traits<Alloc>;
@@ -628,64 +848,152 @@ namespace STRINGBUILDER_NAMESPACE
         using const_reference = const char_type&;
         using pointer = char_type*;
         using const_pointer = const char_type*;
+        using growth_policy_type = GrowthPolicy;
         static constexpr size_t inplace_size = InPlaceSize;
+        /// The claims are never refused, as a new chunk is allocated whenever the current one is too small.
+        static constexpr bool claim_may_refuse = false;
 
     private:
         using Chunk = detail::Chunk<char_type>;
         using ChunkHeader = detail::ChunkHeader<char_type>;
         template<int N> using ChunkInPlace = detail::ChunkInPlace<char_type, N>;
 
+        template<typename, size_t, typename, typename, typename> friend class basic_stringbuilder;
+
     public:
         /// Recreates and returns the allocator originally passed to stringbuilder object during construction (it is kept internally in a rebound form).
         AllocOrig get_allocator() const noexcept { return AllocProvider::get_original_allocator(); }
 
+        /// Gets the growth policy deciding the sizes of the chunks allocated from now on, e.g. to give it a hint.
+        GrowthPolicy& growth_policy() noexcept { return *this; }
+        const GrowthPolicy& growth_policy() const noexcept { return *this; }
+
         template<typename AllocOther = Alloc>
         basic_stringbuilder(AllocOther&& allocOther = AllocOther{}) noexcept : AllocProvider{std::forward<AllocOther>(allocOther)} {}
 
+        /// Builds into the caller's buffer of `bufferSize` characters once the in-place storage is full, and allocates chunks only when the buffer overflows.
+        /// A few bytes at the beginning of the buffer are taken for the chunk bookkeeping. The buffer is never freed by the builder, but it must outlive it.
+        template<typename AllocOther = Alloc>
+        basic_stringbuilder(char_type* buffer, size_type bufferSize, AllocOther&& allocOther = AllocOther{}) noexcept :
+            AllocProvider{std::forward<AllocOther>(allocOther)}
+        {
+            void* space = buffer;
+            size_t spaceBytes = bufferSize * sizeof(char_type);
+            if (std::align(alignof(Chunk), sizeof(Chunk), space, spaceBytes) != nullptr) {
+                headChunk()->next = ::new(space) Chunk{(spaceBytes - sizeof(ChunkHeader)) / sizeof(char_type)};
+                hasExternalChunk = true;
+            }
+        }
+
         basic_stringbuilder(const basic_stringbuilder&) = delete;
 
+        /// Takes over the chunks of the other builder, whose in-place content is copied. The other builder is left empty.
         basic_stringbuilder(basic_stringbuilder&& other) noexcept :
             AllocProvider{other.get_allocator()},
-            headChunkInPlace{other.headChunkInPlace},
-            tailChunk{other.tailChunk}
+            GrowthPolicy{other.growth_policy()}
         {
-            other.headChunkInPlace.next = nullptr;
+            takeOver(other);
         }
 
-        ~basic_stringbuilder()
+        /// Replaces the content with the one of the other builder, taking over its chunks if the allocators allow it. The other builder is left empty.
+        /// Unless the allocator propagates or its instances are always equal, unequal allocators (e.g. of std::pmr builders) make it copy the content,
+        /// which allocates and may throw.
+        basic_stringbuilder& operator=(basic_stringbuilder&& other)
+            noexcept(AllocTraits::propagate_on_container_move_assignment::value || detail::IsAllocatorAlwaysEqual<Alloc>::value)
         {
-            Chunk* nextChunk = headChunk()->next;
-            for (auto chunk = nextChunk; chunk != nullptr; chunk = nextChunk)
-            {
-                nextChunk = chunk->next;
-                //AllocTraits::destroy...?
-                AllocTraits::deallocate(AllocProvider::get_rebound_allocator(), reinterpret_cast<typename AllocTraits::pointer>(chunk), sizeof(ChunkHeader) + chunk->reserved);
+            if (this != &other) {
+                releaseChunks();
+                growth_policy() = other.growth_policy();
+                moveAssign(other, typename AllocTraits::propagate_on_container_move_assignment{});
             }
+            return *this;
+        }
+
+        /// Exchanges the contents of two builders. Only the in-place content is copied; the allocators must be equal, unless they propagate on swap.
+        void swap(basic_stringbuilder& other) noexcept
+        {
+            if (this == &other)
+                return;
+
+            swapAllocators(other, typename AllocTraits::propagate_on_container_swap{});
+            std::swap(growth_policy(), other.growth_policy());
+
+            // With the consumed counts up to date, the head chunks are exchanged like any other chunks, except that their data has to be copied.
+            syncTailChunk();
+            other.syncTailChunk();
+            Chunk* const head = headChunk();
+            Chunk* const otherHead = other.headChunk();
+            std::swap_ranges(head->data, head->data + std::max(head->consumed, otherHead->consumed), otherHead->data);
+            std::swap(head->consumed, otherHead->consumed);
+            std::swap(head->next, otherHead->next);
+            std::swap(hasExternalChunk, other.hasExternalChunk);
+            std::swap(committedSize, other.committedSize);
+            std::swap(tailChunk, other.tailChunk);
+            if (tailChunk == otherHead)
+                tailChunk = head;
+            if (other.tailChunk == head)
+                other.tailChunk = otherHead;
+            enterTailChunk();
+            other.enterTailChunk();
+        }
+
+        friend void swap(basic_stringbuilder& a, basic_stringbuilder& b) noexcept { a.swap(b); }
+
+        ~basic_stringbuilder()
+        {
+            deallocChunks(firstAllocatedChunk());
         }
 
         /// Gets the number of characters appended to the buffer.
+        /// The characters of the chunks preceding the tail one are counted as the tail moves on, so this is O(1).
         size_type size() const noexcept
         {
-            size_type size = 0;
-            const auto* chunk = headChunk();
-            do {
-                size += chunk->consumed;
-                chunk = chunk->next;
-            } while (chunk != nullptr);
-            return size;
+            return committedSize + tailConsumed();
         }
 
         /// Gets the number of characters appended to the buffer.
         size_type length() const noexcept { return size(); }
 
+        /// Discards the content, but keeps all the allocated chunks, so that building the next string reuses them without touching the allocator.
+        void clear() noexcept
+        {
+            // The chunks past the tail one are empty already.
+            for (Chunk* chunk = headChunk(); ; chunk = chunk->next) {
+                chunk->consumed = 0;
+                if (chunk == tailChunk)
+                    break;
+            }
+            tailChunk = headChunk();
+            committedSize = 0;
+            enterTailChunk();
+        }
+
+        /// Discards the content and keeps the leading allocated chunks for reuse as long as their storage in total does not exceed `keepBytes`.
+        /// The remaining chunks are deallocated; reset() with no argument frees all of them, leaving the object as if it were newly constructed.
+        void reset(size_type keepBytes = 0) noexcept
+        {
+            clear();
+
+            Chunk* lastKept = hasExternalChunk ? headChunk()->next : headChunk();
+            for (size_type keptBytes = 0; lastKept->next != nullptr; lastKept = lastKept->next) {
+                keptBytes += chunkStorageSize(lastKept->next);
+                if (keptBytes > keepBytes)
+                    break;
+            }
+            deallocChunks(lastKept->next);
+            lastKept->next = nullptr;
+        }
+
         void reserve(size_type size)
         {
-            for (Chunk* chunk = tailChunk; size > chunk->reserved - chunk->consumed; chunk = chunk->next)
+            // The chunks past the tail one are empty.
+            size_type available = static_cast<size_type>(end - cursor);
+            for (Chunk* chunk = tailChunk; size > available; chunk = chunk->next, available = chunk->reserved)
             {
-                size -= chunk->reserved - chunk->consumed;
+                size -= available;
                 assert(size > 0);
                 if (chunk->next == nullptr) {
-                    chunk->next = allocChunk(size);
+                    chunk->next = allocChunk(size, this->size());
                 }
             }
         }
@@ -746,7 +1054,7 @@ namespace STRINGBUILDER_NAMESPACE
         template<bool Prefetch = false>
         basic_stringbuilder& append_c_str(const char_type* str)
         {
-            if (Prefetch) detail::prefetchWrite(&tailChunk->data[tailChunk->consumed]);
+            if (Prefetch) detail::prefetchWrite(cursor);
             return append(str, Traits::length(str));
         }
 
@@ -795,8 +1103,8 @@ namespace STRINGBUILDER_NAMESPACE
         }
 
         /// Appends a string builder.
-        template<size_type OtherInPlaceSize, typename OtherTraits, typename OtherAlloc>
-        basic_stringbuilder& append(const basic_stringbuilder<char_type, OtherInPlaceSize, OtherTraits, OtherAlloc>& sb)
+        template<size_type OtherInPlaceSize, typename OtherTraits, typename OtherAlloc, typename OtherGrowthPolicy>
+        basic_stringbuilder& append(const basic_stringbuilder<char_type, OtherInPlaceSize, OtherTraits, OtherAlloc, OtherGrowthPolicy>& sb)
         {
             size_type size = sb.size();
             reserve(size);
@@ -804,7 +1112,7 @@ namespace STRINGBUILDER_NAMESPACE
             const Chunk* chunk = sb.headChunk();
             while (size > 0) {
                 assert(chunk != nullptr);
-                const size_type toCopy = std::min(size, chunk->consumed);
+                const size_type toCopy = std::min(size, sb.consumedOf(chunk));
                 append(chunk->data, toCopy);
                 size -= toCopy;
                 chunk = chunk->next;
@@ -841,6 +1149,30 @@ namespace STRINGBUILDER_NAMESPACE
             return append(std::forward<AnyT1>(any1)).append_many(std::forward<AnyTX>(anyX)...);
         }
 
+        /// Appends the objects of the range [first, last) separated with the specified number of characters of a given string, e.g. a row of CSV.
+        /// The range is traversed once. A range of integers is encoded in batches, each into space claimed for the worst case of the whole batch, with the unused rest given back.
+        template<typename ForwardIt>
+        basic_stringbuilder& append_range(ForwardIt first, ForwardIt last, const char_type* separator, size_type separatorSize)
+        {
+            sb_range_appender<basic_stringbuilder, typename std::iterator_traits<ForwardIt>::value_type>{}(*this, first, last, separator, separatorSize);
+            return *this;
+        }
+
+        /// Appends the objects of the range [first, last) separated with a given string literal.
+        template<typename ForwardIt, size_type SeparatorSizeWith0>
+        basic_stringbuilder& append_range(ForwardIt first, ForwardIt last, const char_type(&separator)[SeparatorSizeWith0])
+        {
+            assert(separator[SeparatorSizeWith0-1] == 0);
+            return append_range(first, last, separator, SeparatorSizeWith0-1);
+        }
+
+        /// Appends the objects of the range [first, last) separated with a given character.
+        template<typename ForwardIt>
+        basic_stringbuilder& append_range(ForwardIt first, ForwardIt last, char_type separator)
+        {
+            return append_range(first, last, &separator, 1);
+        }
+
         /// Creates and returns a string object containing a copy of all appended characters.
         std::basic_string<char_type> str() const
         {
@@ -849,19 +1181,53 @@ namespace STRINGBUILDER_NAMESPACE
             str.reserve(size0);
             for (const Chunk* chunk = headChunk(); chunk != nullptr; chunk = chunk->next)
             {
-                str.append(chunk->data, chunk->consumed);
+                str.append(chunk->data, consumedOf(chunk));
             }
             return str;
         }
 
+        /// Appends the content to the target string, which grows only if its capacity is insufficient.
+        /// Where std::basic_string::resize_and_overwrite() is available, the chunks are copied into the grown string without initializing it first.
+        template<typename OtherTraits, typename OtherAlloc>
+        void append_to(std::basic_string<char_type, OtherTraits, OtherAlloc>& target) const
+        {
+            const size_type offset = target.size();
+            const size_type totalSize = offset + size();
+#if __cpp_lib_string_resize_and_overwrite
+            target.resize_and_overwrite(totalSize, [this, offset](char_type* out, size_type n) {
+                out += offset;
+                for_each_chunk([&out](const char_type* data, size_type size) {
+                    Traits::copy(out, data, size);
+                    out += size;
+                });
+                return n;
+            });
+#else
+            // Growing geometrically keeps the appends of many builders to one string linear.
+            if (target.capacity() < totalSize)
+                target.reserve(std::max(totalSize, 2 * target.capacity()));
+            for_each_chunk([&target](const char_type* data, size_type size) {
+                target.append(data, size);
+            });
+#endif
+        }
+
+        /// Replaces the target string with the content, reusing the capacity of the target instead of allocating a new string like str().
+        template<typename OtherTraits, typename OtherAlloc>
+        void assign_to(std::basic_string<char_type, OtherTraits, OtherAlloc>& target) const
+        {
+            target.clear();
+            append_to(target);
+        }
+
         /// Checks whether the contained (valid) characters form a linear buffer in memory.
         bool is_linear() const
         {
             const auto* chunk = headChunk();
-            bool has_data = chunk->consumed > 0;
+            bool has_data = consumedOf(chunk) > 0;
             while (chunk->next) {
                 chunk = chunk->next;
-                if (chunk->consumed > 0) {
+                if (consumedOf(chunk) > 0) {
                     if (has_data)
                         return false;
                     has_data = true;
@@ -870,6 +1236,90 @@ namespace STRINGBUILDER_NAMESPACE
             return true;
         }
 
+        /// Calls `visitor(const char_type* data, size_type size)` for every non-empty chunk, in order, so that the content can be read without copying.
+        template<typename Visitor>
+        void for_each_chunk(Visitor&& visitor) const
+        {
+            // The chunks past the tail one are empty.
+            for (const Chunk* chunk = headChunk(); ; chunk = chunk->next) {
+                const size_type consumed = consumedOf(chunk);
+                if (consumed > 0) {
+                    visitor(static_cast<const char_type*>(chunk->data), consumed);
+                }
+                if (chunk == tailChunk)
+                    break;
+            }
+        }
+
+        /// Position in the chain of chunks, at which an export of the content continues. A default-constructed one stands for the beginning.
+        class chunk_position
+        {
+        public:
+            bool at_end() const noexcept { return atEnd; }
+
+        private:
+            friend class basic_stringbuilder;
+            const Chunk* chunk = nullptr;
+            bool atEnd = false;
+        };
+
+#ifdef STRINGBUILDER_SUPPORTS_IOVEC
+        /// Fills up to `count` iovec structures with the non-empty chunks from `position` on, and returns the number of structures filled.
+        /// The position is advanced, so that a subsequent call continues where this one stopped, e.g. when there are more chunks than IOV_MAX.
+        /// The iovec structures point into the builder, so they are valid until it is modified.
+        /// The `count` must not be zero (which is asserted), since a call which fills nothing would never advance the position to the end.
+        size_type to_iovec(struct iovec* iov, size_type count, chunk_position& position) const noexcept
+        {
+            assert(count > 0 && "At least one iovec structure is needed to advance the position");
+            if (position.atEnd)
+                return 0;
+
+            size_type filled = 0;
+            const Chunk* chunk = position.chunk != nullptr ? position.chunk : headChunk();
+            for (; filled < count; chunk = chunk->next) {
+                const size_type consumed = consumedOf(chunk);
+                if (consumed > 0) {
+                    iov[filled].iov_base = const_cast<char_type*>(static_cast<const char_type*>(chunk->data));
+                    iov[filled].iov_len = consumed * sizeof(char_type);
+                    ++filled;
+                }
+                if (chunk == tailChunk) {
+                    position.atEnd = true;
+                    return filled;
+                }
+            }
+            position.chunk = chunk;
+            return filled;
+        }
+
+        /// Writes the content to the file descriptor with as few writev() calls as possible, resuming after partial writes and EINTR.
+        /// Unlike printing to std::ostream, there is neither a call per chunk nor stream locking. Throws std::system_error if writing fails.
+        /// With `consume`, the characters written are removed from the builder, also when an error (e.g. EAGAIN) interrupts the writing.
+        /// The chunks emptied this way are kept for reuse like with clear(); reset() frees them.
+        void write_to(int fd, bool consume = false)
+        {
+            struct iovec iov[detail::iovBatchSize];
+            auto position = chunk_position{};
+            size_t written = 0;
+            int error = 0;
+            while (error == 0 && !position.at_end()) {
+                const size_type count = to_iovec(iov, detail::iovBatchSize, position);
+                error = detail::writevFully(fd, iov, count, written);
+            }
+
+            if (consume) {
+                if (error == 0) {
+                    clear();
+                }
+                else {
+                    discardFront(written / sizeof(char_type));
+                }
+            }
+            if (error != 0)
+                throw std::system_error{error, std::generic_category(), "writev"};
+        }
+#endif
+
 #if STRINGBUILDER_USES_STRING_VIEW
         /// Returns a string_view spanning over all appended characters.
         /// The retrieved string is not null-terminated.
@@ -877,11 +1327,11 @@ namespace STRINGBUILDER_NAMESPACE
         {
             assert(is_linear());
             const auto* chunk = headChunk();
-            while (chunk->consumed == 0) {
+            while (consumedOf(chunk) == 0) {
                 chunk = chunk->next;
                 assert(chunk != nullptr);
             }
-            return { chunk->data, chunk->consumed };
+            return { chunk->data, consumedOf(chunk) };
         }
 #endif
 
@@ -890,63 +1340,167 @@ namespace STRINGBUILDER_NAMESPACE
         template<typename OtherCharTraitsT>
         friend std::basic_ostream<char_type, OtherCharTraitsT>& operator<<(
             std::basic_ostream<char_type, OtherCharTraitsT>& out,
-            const basic_stringbuilder<char_type, inplace_size, traits_type, allocator_type>& sb)
+            const basic_stringbuilder<char_type, inplace_size, traits_type, allocator_type, growth_policy_type>& sb)
         {
             for (const Chunk* chunk = sb.headChunk(); chunk != nullptr; chunk = chunk->next)
             {
-                out.write(chunk->data, static_cast<std::streamsize>(chunk->consumed));
+                out.write(chunk->data, static_cast<std::streamsize>(sb.consumedOf(chunk)));
             }
             return out;
         }
 
-    private:
-        Chunk* headChunk() noexcept { return reinterpret_cast<Chunk*>(&headChunkInPlace); }
-        const Chunk* headChunk() const noexcept { return reinterpret_cast<const Chunk*>(&headChunkInPlace); }
-
+        /// Claims exactly the specified number of characters at the end of the content and returns the pointer to the first of them.
+        /// The claimed characters are counted as appended right away, so the caller is obliged to fill all of them in.
+        /// The claimed space is always contiguous: if the tail chunk cannot hold it, the content continues in the next chunk.
         char_type* claim(size_type exact)
         {
-            if (STRINGBUILDER_UNLIKELY(tailChunk->reserved - tailChunk->consumed < exact))
+            if (STRINGBUILDER_UNLIKELY(static_cast<size_type>(end - cursor) < exact))
                 prepareSpace(exact);
 
-            char_type* const claimedChars = &tailChunk->data[tailChunk->consumed];
-            tailChunk->consumed += exact;
+            char_type* const claimedChars = cursor;
+            cursor += exact;
             return claimedChars;
         }
 
+        /// Claims at least `minimum` and at most `maximum` contiguous characters at the end of the content.
+        /// Returns the pointer to the first claimed character along with the number of characters actually claimed.
+        /// The claimed characters are counted as appended right away - the ones left unfilled must be given back with reclaim().
         std::pair<char_type*, size_type> claim(size_type minimum, size_type maximum)
         {
             assert(maximum >= minimum);
-            assert(tailChunk->reserved >= tailChunk->consumed);
+            assert(end >= cursor);
 
-            if (STRINGBUILDER_UNLIKELY(tailChunk->reserved - tailChunk->consumed < minimum))
+            if (STRINGBUILDER_UNLIKELY(static_cast<size_type>(end - cursor) < minimum))
                 prepareSpace(minimum, maximum);
 
-            assert(tailChunk->reserved >= tailChunk->consumed);
-            assert(minimum <= tailChunk->reserved - tailChunk->consumed);
+            assert(end >= cursor);
+            assert(minimum <= static_cast<size_type>(end - cursor));
 
-            const size_type claimedSize = std::min(maximum, tailChunk->reserved - tailChunk->consumed);
-            const auto claimed = std::make_pair(&tailChunk->data[tailChunk->consumed], claimedSize);
-            tailChunk->consumed += claimedSize;
+            const size_type claimedSize = std::min(maximum, static_cast<size_type>(end - cursor));
+            const auto claimed = std::make_pair(cursor, claimedSize);
+            cursor += claimedSize;
             return claimed;
         }
 
+        /// Gives back the specified number of the most recently claimed characters, which have not been filled in.
+        void reclaim(size_type exact)
+        {
+            assert(tailConsumed() >= exact);
+            cursor -= exact;
+        }
+
+    private:
+        Chunk* headChunk() noexcept { return reinterpret_cast<Chunk*>(&headChunkInPlace); }
+        const Chunk* headChunk() const noexcept { return reinterpret_cast<const Chunk*>(&headChunkInPlace); }
+
         Char& claimOne()
         {
-            if (STRINGBUILDER_UNLIKELY(tailChunk->reserved - tailChunk->consumed < 1))
+            if (STRINGBUILDER_UNLIKELY(cursor == end))
                 prepareSpace(1);
-            return tailChunk->data[tailChunk->consumed++];
+            return *(cursor++);
+        }
+
+        /// Gets the number of characters appended to the tail chunk, whose `consumed` is not kept up to date (the cursor is).
+        size_type tailConsumed() const noexcept { return static_cast<size_type>(cursor - tailChunk->data); }
+
+        /// Gets the number of characters appended to a chunk.
+        size_type consumedOf(const Chunk* chunk) const noexcept { return chunk == tailChunk ? tailConsumed() : chunk->consumed; }
+
+        /// Writes the cursor back to the tail chunk.
+        void syncTailChunk() noexcept { tailChunk->consumed = tailConsumed(); }
+
+        /// Writes the cursor back to the tail chunk, which is about to be left.
+        /// The chunks passed by are either the current tail or empty ones, so only the tail adds to the committed size.
+        void leaveTailChunk() noexcept
+        {
+            syncTailChunk();
+            committedSize += tailChunk->consumed;
+        }
+
+        /// Removes the first `count` characters, e.g. the ones already written out. The chunks emptied on the way stay in the chain.
+        void discardFront(size_type count) noexcept
+        {
+            assert(count <= size());
+            syncTailChunk();
+            for (Chunk* chunk = headChunk(); count > 0; chunk = chunk->next) {
+                const size_type dropped = std::min(count, chunk->consumed);
+                Traits::move(chunk->data, chunk->data + dropped, chunk->consumed - dropped);
+                chunk->consumed -= dropped;
+                if (chunk != tailChunk)
+                    committedSize -= dropped;
+                count -= dropped;
+            }
+            enterTailChunk();
+        }
+
+        /// Moves the content of the other builder into this one, which must be empty and hold no allocated chunks.
+        /// The heap chunks change hands, so the allocators must be equal.
+        void takeOver(basic_stringbuilder& other) noexcept
+        {
+            assert(headChunk()->next == nullptr && size() == 0);
+
+            other.syncTailChunk();
+            Chunk* const head = headChunk();
+            Chunk* const otherHead = other.headChunk();
+            Traits::copy(head->data, otherHead->data, otherHead->consumed);
+            head->consumed = otherHead->consumed;
+            head->next = otherHead->next;
+            hasExternalChunk = other.hasExternalChunk;
+            committedSize = other.committedSize;
+            tailChunk = other.tailChunk == otherHead ? head : other.tailChunk;
+            enterTailChunk();
+
+            otherHead->consumed = 0;
+            otherHead->next = nullptr;
+            other.hasExternalChunk = false;
+            other.committedSize = 0;
+            other.tailChunk = otherHead;
+            other.enterTailChunk();
+        }
+
+        void moveAssign(basic_stringbuilder& other, std::true_type /*propagate allocator*/) noexcept
+        {
+            static_cast<AllocProvider&>(*this) = std::move(static_cast<AllocProvider&>(other));
+            takeOver(other);
+        }
+
+        void moveAssign(basic_stringbuilder& other, std::false_type /*propagate allocator*/)
+        {
+            if (AllocProvider::get_rebound_allocator() == other.get_rebound_allocator()) {
+                takeOver(other);
+            }
+            else {
+                // The chunks of the other builder cannot be freed with this allocator - copy the content instead.
+                append(other);
+                other.reset();
+            }
+        }
+
+        void swapAllocators(basic_stringbuilder& other, std::true_type /*propagate allocator*/) noexcept
+        {
+            using std::swap;
+            swap(AllocProvider::get_rebound_allocator(), other.get_rebound_allocator());
+        }
+
+        void swapAllocators(basic_stringbuilder& other, std::false_type /*propagate allocator*/) noexcept
+        {
+            assert(AllocProvider::get_rebound_allocator() == other.get_rebound_allocator() && "Swapping builders with unequal allocators");
+            (void)other;
         }
 
-        void reclaim(size_t exact)
+        /// Points the cursor to the free space of the (new) tail chunk.
+        void enterTailChunk() noexcept
         {
-            assert(tailChunk->consumed >= exact);
-            tailChunk->consumed -= exact;
+            cursor = tailChunk->data + tailChunk->consumed;
+            end = tailChunk->data + tailChunk->reserved;
         }
 
         STRINGBUILDER_NOINLINE void prepareSpace(size_type minimum)
         {
+            leaveTailChunk();
+
             if (tailChunk->next == nullptr) {
-                tailChunk->next = allocChunk(minimum);
+                tailChunk->next = allocChunk(minimum, committedSize);
                 tailChunk = tailChunk->next;
             }
             else {
@@ -954,18 +1508,22 @@ namespace STRINGBUILDER_NAMESPACE
                     tailChunk = tailChunk->next;
                     assert(tailChunk->consumed == 0);
                     if (tailChunk->reserved >= minimum)
-                        return;
+                        break;
 
                     if (tailChunk->next == nullptr)
-                        tailChunk->next = allocChunk(minimum);
+                        tailChunk->next = allocChunk(minimum, committedSize);
                 }
             }
+
+            enterTailChunk();
         }
 
         STRINGBUILDER_NOINLINE void prepareSpace(size_type minimum, size_type maximum)
         {
+            leaveTailChunk();
+
             if (tailChunk->next == nullptr) {
-                tailChunk->next = allocChunk(maximum);
+                tailChunk->next = allocChunk(maximum, committedSize);
                 tailChunk = tailChunk->next;
             }
             else
@@ -975,36 +1533,70 @@ namespace STRINGBUILDER_NAMESPACE
                     assert(tailChunk->consumed == 0);
 
                     if (tailChunk->reserved >= minimum)
-                        return;
+                        break;
 
                     if (tailChunk->next == nullptr)
-                        tailChunk->next = allocChunk(maximum);
+                        tailChunk->next = allocChunk(maximum, committedSize);
                 }
             }
+
+            enterTailChunk();
+        }
+
+        constexpr static size_type roundToGranularity(size_type size) noexcept
+        {
+            return ((GrowthPolicy::granularity - 1) + size) / GrowthPolicy::granularity * GrowthPolicy::granularity;
         }
 
-        size_type determineNextChunkSize(size_type minimum) const noexcept { return std::max(2 * tailChunk->reserved, minimum); }
+        /// Gets the number of bytes allocated for a chunk. The bytes left over after its last whole character are recovered by the rounding.
+        static size_type chunkStorageSize(const Chunk* chunk) noexcept { return roundToGranularity(sizeof(ChunkHeader) + chunk->reserved * sizeof(char_type)); }
 
-        constexpr static size_type l1DataCacheLineSize = 64; //std::hardware_destructive_interference_size;
+        /// Gets the first chunk owned by the builder, past the in-place one and the caller's buffer.
+        Chunk* firstAllocatedChunk() noexcept
+        {
+            Chunk* const chunk = headChunk()->next;
+            return hasExternalChunk ? chunk->next : chunk;
+        }
+
+        /// Frees the allocated chunks and lets go of the caller's buffer, leaving the builder as if it was just default-constructed.
+        void releaseChunks() noexcept
+        {
+            clear();
+            deallocChunks(firstAllocatedChunk());
+            headChunk()->next = nullptr;
+            hasExternalChunk = false;
+        }
 
-        constexpr static size_type roundToL1DataCacheLine(size_type size) noexcept
+        void deallocChunks(Chunk* chunk) noexcept
         {
-            return ((l1DataCacheLineSize - 1) + size) / l1DataCacheLineSize * l1DataCacheLineSize;
+            if (is_arena_allocator<AllocOrig>::value)
+                return;
+            while (chunk != nullptr) {
+                Chunk* const nextChunk = chunk->next;
+                AllocTraits::deallocate(AllocProvider::get_rebound_allocator(), reinterpret_cast<typename AllocTraits::pointer>(chunk), chunkStorageSize(chunk));
+                chunk = nextChunk;
+            }
         }
 
-        Chunk* allocChunk(size_type minimum)
+        /// Allocates a chunk of at least `minimum` characters, given the number of characters appended before it.
+        Chunk* allocChunk(size_type minimum, size_type contentSize)
         {
             assert(minimum > 0);
-            const auto chunkTotalSize = roundToL1DataCacheLine(determineNextChunkSize(minimum) + sizeof(ChunkHeader));
+            const size_type chunkSize = std::max(growth_policy().next_chunk_size(contentSize, tailChunk->reserved, minimum), minimum);
+            const auto chunkTotalSize = roundToGranularity(sizeof(ChunkHeader) + chunkSize * sizeof(char_type));
             auto* rawChunk = AllocTraits::allocate(AllocProvider::get_rebound_allocator(), chunkTotalSize, tailChunk);
             auto* chunk = reinterpret_cast<Chunk*>(rawChunk);
-            AllocTraits::construct(AllocProvider::get_rebound_allocator(), chunk, chunkTotalSize - sizeof(ChunkHeader));
+            AllocTraits::construct(AllocProvider::get_rebound_allocator(), chunk, (chunkTotalSize - sizeof(ChunkHeader)) / sizeof(char_type));
             return chunk;
         }
 
     private:
         ChunkInPlace<InPlaceSize> headChunkInPlace;
         Chunk* tailChunk = headChunk();
+        size_type committedSize = 0;    // The number of characters in the chunks preceding tailChunk.
+        char_type* cursor = headChunk()->data;              // The next character to append. It stands for tailChunk->consumed, which is synchronized only when leaving the chunk.
+        char_type* end = headChunk()->data + InPlaceSize;   // The end of the space reserved by tailChunk.
+        bool hasExternalChunk = false;  // Whether the chunk following the in-place one lies in the caller's buffer.
     };
 
 } // namespace STRINGBUILDER_NAMESPACE
@@ -1017,8 +1609,8 @@ namespace std
         return sb.str();
     }
 
-    template<typename CharT, size_t InPlaceSize, typename Traits, typename Alloc>
-    inline std::basic_string<CharT> to_string(const STRINGBUILDER_NAMESPACE::basic_stringbuilder<CharT, InPlaceSize, Traits, Alloc>& sb)
+    template<typename CharT, size_t InPlaceSize, typename Traits, typename Alloc, typename GrowthPolicy>
+    inline std::basic_string<CharT> to_string(const STRINGBUILDER_NAMESPACE::basic_stringbuilder<CharT, InPlaceSize, Traits, Alloc, GrowthPolicy>& sb)
     {
         return sb.str();
     }
@@ -1040,64 +1632,2157 @@ namespace STRINGBUILDER_NAMESPACE
     using inplace_u32stringbuilder = basic_inplace_stringbuilder<char32_t, MaxSize, Forward, Traits, OverflowPolicy>;
 
 
-    template<int InPlaceSize = 0, typename Traits = std::char_traits<char>, typename Alloc = std::allocator<char>>
-    using stringbuilder = basic_stringbuilder<char, InPlaceSize, Traits, Alloc>;
+    namespace detail
+    {
+        /// Free lists of the blocks released by pooled_allocator on the current thread, one list per power-of-two size class.
+        /// The state is trivially destructible, so it stays valid until the very end of the thread (when ChunkPoolDrainer has emptied it).
+        struct ChunkPoolState
+        {
+            static constexpr size_t minBlockSize = 64;    // The size of L1 data cache line, just like the chunks of basic_stringbuilder are rounded to.
+            static constexpr size_t sizeClassCount = 25;  // Up to 1 GiB.
 
-    template<int InPlaceSize = 0, typename Traits = std::char_traits<wchar_t>, typename Alloc = std::allocator<wchar_t>>
-    using wstringbuilder = basic_stringbuilder<wchar_t, InPlaceSize, Traits, Alloc>;
+            void* freeLists[sizeClassCount];
+            size_t pooledBytes;
+            bool drainerRegistered;
+            bool drained;
 
-    template<int InPlaceSize = 0, typename Traits = std::char_traits<char16_t>, typename Alloc = std::allocator<char16_t>>
-    using u16stringbuilder = basic_stringbuilder<char16_t, InPlaceSize, Traits, Alloc>;
+            static size_t sizeClassOf(size_t bytes) noexcept
+            {
+                size_t sizeClass = 0;
+                for (size_t blockSize = minBlockSize; blockSize < bytes; blockSize *= 2) {
+                    ++sizeClass;
+                }
+                return sizeClass;
+            }
 
-    template<int InPlaceSize = 0, typename Traits = std::char_traits<char32_t>, typename Alloc = std::allocator<char32_t>>
-    using u32wstringbuilder = basic_stringbuilder<char32_t, InPlaceSize, Traits, Alloc>;
+            static constexpr size_t blockSizeOf(size_t sizeClass) noexcept { return minBlockSize << sizeClass; }
+        };
 
+        inline ChunkPoolState& chunkPoolState() noexcept
+        {
+            static thread_local ChunkPoolState state;  // Zero-initialized.
+            return state;
+        }
 
-    template<typename SB, typename IntegerT>
-    struct sb_appender<SB, IntegerT, typename std::enable_if<
-        std::is_integral<IntegerT>::value && !::std::is_same<IntegerT, typename SB::char_type>::value >::type>
-    {
-        void operator()(SB& sb, IntegerT iv) const
+        /// Returns the pooled blocks to the global heap when the thread exits. Blocks released afterwards (e.g. by static objects) are not pooled anymore.
+        struct ChunkPoolDrainer
         {
-            // In this particular case, std::div() is x2 slower instead of / and %.
-            if (iv >= 0) {
-                if (iv >= 10) {
-                    basic_inplace_stringbuilder<typename SB::char_type, 20, false, typename SB::traits_type> bss;
-                    do {
-                        bss.append(static_cast<typename SB::char_type>('0' + iv % 10));
-                        iv /= 10;
-                    } while (iv > 0);
-                    sb.append(bss);
-                }
-                else {
-                    sb.append(static_cast<typename SB::char_type>('0' + static_cast<char>(iv)));
-                }
-            }
-            else {
-                if (iv <= -10) {
-                    basic_inplace_stringbuilder<typename SB::char_type, 20, false, typename SB::traits_type> bss;
-                    do {
-                        bss.append(static_cast<typename SB::char_type>('0' - iv % 10));
-                        iv /= 10;
-                    } while (iv < 0);
-                    bss.append('-');
-                    sb.append(bss);
-                }
-                else {
-                    sb.append('-');
-                    sb.append(static_cast<typename SB::char_type>('0' - static_cast<char>(iv)));
+            ~ChunkPoolDrainer()
+            {
+                auto& state = chunkPoolState();
+                for (void*& freeList : state.freeLists) {
+                    while (freeList != nullptr) {
+                        void* const next = *static_cast<void**>(freeList);
+                        ::operator delete(freeList);
+                        freeList = next;
+                    }
                 }
+                state.pooledBytes = 0;
+                state.drained = true;
             }
+        };
+
+        STRINGBUILDER_NOINLINE inline void registerChunkPoolDrainer()
+        {
+            static thread_local ChunkPoolDrainer drainer;
+            (void)drainer;
+            chunkPoolState().drainerRegistered = true;
         }
-    };
+    }
 
+    /// Allocator which keeps the released blocks in per-thread free lists and hands them out again, instead of going to the global heap each time.
+    /// Block sizes are rounded up to a power of two (at least an L1 data cache line), so the chunks of short-lived string builders get recycled by the next ones.
+    /// Blocks larger than MaxBlockSize are not pooled, neither are the ones which would make the pool of the thread hold more than MaxPooledBytes.
+    /// A block may be released on another thread than it was allocated on - it joins the pool of the releasing thread then.
+    template<typename T, size_t MaxPooledBytes = 4 * 1024 * 1024, size_t MaxBlockSize = 256 * 1024>
+    class pooled_allocator
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported");
+        static_assert(MaxBlockSize <= detail::ChunkPoolState::blockSizeOf(detail::ChunkPoolState::sizeClassCount - 1), "MaxBlockSize is too large");
 
-#if __cpp_lib_integer_sequence && __cpp_lib_void_t
-#define STRINGBUILDER_SUPPORTS_MAKE_STRING
+    public:
+        using value_type = T;
+        template<typename U> struct rebind { using other = pooled_allocator<U, MaxPooledBytes, MaxBlockSize>; };
 
-    template<typename CharT, size_t N, size_t... IX>
-    struct constexpr_str
-    {
+        pooled_allocator() noexcept = default;
+        template<typename U> pooled_allocator(const pooled_allocator<U, MaxPooledBytes, MaxBlockSize>&) noexcept {}
+
+        T* allocate(size_t n)
+        {
+            const size_t bytes = n * sizeof(T);
+            if (STRINGBUILDER_UNLIKELY(bytes > MaxBlockSize))
+                return static_cast<T*>(::operator new(bytes));
+
+            auto& state = detail::chunkPoolState();
+            const size_t sizeClass = detail::ChunkPoolState::sizeClassOf(bytes);
+            void* const block = state.freeLists[sizeClass];
+            if (block == nullptr)
+                return static_cast<T*>(::operator new(detail::ChunkPoolState::blockSizeOf(sizeClass)));
+
+            state.freeLists[sizeClass] = *static_cast<void**>(block);
+            state.pooledBytes -= detail::ChunkPoolState::blockSizeOf(sizeClass);
+            return static_cast<T*>(block);
+        }
+
+        void deallocate(T* p, size_t n) noexcept
+        {
+            const size_t bytes = n * sizeof(T);
+            auto& state = detail::chunkPoolState();
+            const size_t sizeClass = detail::ChunkPoolState::sizeClassOf(bytes);
+            if (bytes > MaxBlockSize || state.drained || state.pooledBytes + detail::ChunkPoolState::blockSizeOf(sizeClass) > MaxPooledBytes) {
+                ::operator delete(p);
+                return;
+            }
+
+            if (STRINGBUILDER_UNLIKELY(!state.drainerRegistered))
+                detail::registerChunkPoolDrainer();
+
+            *reinterpret_cast<void**>(p) = state.freeLists[sizeClass];
+            state.freeLists[sizeClass] = p;
+            state.pooledBytes += detail::ChunkPoolState::blockSizeOf(sizeClass);
+        }
+
+        template<typename U>
+        bool operator==(const pooled_allocator<U, MaxPooledBytes, MaxBlockSize>&) const noexcept { return true; }
+        template<typename U>
+        bool operator!=(const pooled_allocator<U, MaxPooledBytes, MaxBlockSize>&) const noexcept { return false; }
+    };
+
+
+    /// Allocator serving the blocks of at least Threshold bytes straight with mmap(), backed by huge pages where the system provides them:
+    /// explicitly reserved ones (MAP_HUGETLB) if available, or else transparent ones (requested with madvise(MADV_HUGEPAGE) for a 2 MiB aligned mapping).
+    /// Huge chunks of a string builder then take a few TLB entries instead of thousands. Smaller blocks (and all blocks where mmap() is not available) come from operator new.
+    template<typename T, size_t Threshold = 2 * 1024 * 1024>
+    class huge_page_allocator
+    {
+    public:
+        using value_type = T;
+        template<typename U> struct rebind { using other = huge_page_allocator<U, Threshold>; };
+
+        static constexpr size_t huge_page_size = 2 * 1024 * 1024;
+
+        huge_page_allocator() noexcept = default;
+        template<typename U> huge_page_allocator(const huge_page_allocator<U, Threshold>&) noexcept {}
+
+        T* allocate(size_t n)
+        {
+            const size_t bytes = n * sizeof(T);
+#ifdef STRINGBUILDER_SUPPORTS_MMAP
+            if (bytes >= Threshold)
+                return static_cast<T*>(mapHugePages(roundToHugePage(bytes)));
+#endif
+            return static_cast<T*>(::operator new(bytes));
+        }
+
+        void deallocate(T* p, size_t n) noexcept
+        {
+            const size_t bytes = n * sizeof(T);
+#ifdef STRINGBUILDER_SUPPORTS_MMAP
+            if (bytes >= Threshold) {
+                munmap(p, roundToHugePage(bytes));
+                return;
+            }
+#endif
+            ::operator delete(p);
+        }
+
+        template<typename U>
+        bool operator==(const huge_page_allocator<U, Threshold>&) const noexcept { return true; }
+        template<typename U>
+        bool operator!=(const huge_page_allocator<U, Threshold>&) const noexcept { return false; }
+
+    private:
+        static constexpr size_t roundToHugePage(size_t bytes) noexcept { return (bytes + (huge_page_size - 1)) / huge_page_size * huge_page_size; }
+
+#ifdef STRINGBUILDER_SUPPORTS_MMAP
+        static void* mapHugePages(size_t mappedBytes)
+        {
+#ifdef MAP_HUGETLB
+            void* const hugeTlbMapping = mmap(nullptr, mappedBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            if (hugeTlbMapping != MAP_FAILED)
+                return hugeTlbMapping;
+#endif
+            // No huge pages reserved: map with the slack to align the mapping to a huge page and give back the excess on both ends.
+            void* const mapping = mmap(nullptr, mappedBytes + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapping == MAP_FAILED)
+                throw std::bad_alloc{};
+
+            char* const begin = static_cast<char*>(mapping);
+            char* const alignedBegin = begin + (huge_page_size - reinterpret_cast<uintptr_t>(begin) % huge_page_size) % huge_page_size;
+            if (alignedBegin != begin)
+                munmap(begin, static_cast<size_t>(alignedBegin - begin));
+            if (alignedBegin + mappedBytes != begin + mappedBytes + huge_page_size)
+                munmap(alignedBegin + mappedBytes, static_cast<size_t>(begin + huge_page_size - alignedBegin));
+#ifdef MADV_HUGEPAGE
+            madvise(alignedBegin, mappedBytes, MADV_HUGEPAGE);
+#endif
+            return alignedBegin;
+        }
+#endif
+    };
+
+
+#ifdef STRINGBUILDER_SUPPORTS_PMR
+    namespace pmr
+    {
+        /// Polymorphic allocator of a memory arena, like std::pmr::monotonic_buffer_resource, which frees all the memory at once when released.
+        /// The builders never give their chunks back to it, so it must not be used with a resource which relies on that (e.g. the default one).
+        template<typename T>
+        class arena_allocator : public std::pmr::polymorphic_allocator<T>
+        {
+        public:
+            template<typename U> struct rebind { using other = arena_allocator<U>; };
+
+            arena_allocator(std::pmr::memory_resource* resource) noexcept : std::pmr::polymorphic_allocator<T>{resource} {}
+            template<typename U> arena_allocator(const arena_allocator<U>& other) noexcept : std::pmr::polymorphic_allocator<T>{other.resource()} {}
+        };
+    }
+
+    template<typename T>
+    struct is_arena_allocator<pmr::arena_allocator<T>> : std::true_type {};
+#endif
+
+    template<int InPlaceSize = 0, typename Traits = std::char_traits<char>, typename Alloc = std::allocator<char>, typename GrowthPolicy = geometric_growth<>>
+    using stringbuilder = basic_stringbuilder<char, InPlaceSize, Traits, Alloc, GrowthPolicy>;
+
+    template<int InPlaceSize = 0, typename Traits = std::char_traits<char>>
+    using pooled_stringbuilder = basic_stringbuilder<char, InPlaceSize, Traits, pooled_allocator<char>>;
+
+    template<int InPlaceSize = 0, typename Traits = std::char_traits<wchar_t>, typename Alloc = std::allocator<wchar_t>, typename GrowthPolicy = geometric_growth<>>
+    using wstringbuilder = basic_stringbuilder<wchar_t, InPlaceSize, Traits, Alloc, GrowthPolicy>;
+
+    template<int InPlaceSize = 0, typename Traits = std::char_traits<char16_t>, typename Alloc = std::allocator<char16_t>, typename GrowthPolicy = geometric_growth<>>
+    using u16stringbuilder = basic_stringbuilder<char16_t, InPlaceSize, Traits, Alloc, GrowthPolicy>;
+
+    template<int InPlaceSize = 0, typename Traits = std::char_traits<char32_t>, typename Alloc = std::allocator<char32_t>, typename GrowthPolicy = geometric_growth<>>
+    using u32wstringbuilder = basic_stringbuilder<char32_t, InPlaceSize, Traits, Alloc, GrowthPolicy>;
+
+#ifdef STRINGBUILDER_SUPPORTS_PMR
+    namespace pmr
+    {
+        template<int InPlaceSize = 0, typename Traits = std::char_traits<char>, typename GrowthPolicy = geometric_growth<>>
+        using stringbuilder = basic_stringbuilder<char, InPlaceSize, Traits, std::pmr::polymorphic_allocator<char>, GrowthPolicy>;
+
+        template<int InPlaceSize = 0, typename Traits = std::char_traits<wchar_t>, typename GrowthPolicy = geometric_growth<>>
+        using wstringbuilder = basic_stringbuilder<wchar_t, InPlaceSize, Traits, std::pmr::polymorphic_allocator<wchar_t>, GrowthPolicy>;
+
+        /// Builder taking its chunks from a memory arena, which frees them all at once. Nothing is deallocated by the builder itself.
+        template<int InPlaceSize = 0, typename Traits = std::char_traits<char>, typename GrowthPolicy = geometric_growth<>>
+        using arena_stringbuilder = basic_stringbuilder<char, InPlaceSize, Traits, arena_allocator<char>, GrowthPolicy>;
+    }
+#endif
+
+
+    namespace detail
+    {
+        /// Lookup table of all two-digit decimal numbers: characters [2*i] and [2*i+1] spell the number i, for i in [0, 100).
+        template<typename Dummy = void>
+        struct DecimalDigitPairs
+        {
+            static const char table[201];
+        };
+
+        template<typename Dummy>
+        const char DecimalDigitPairs<Dummy>::table[201] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        /// Tells whether T is an integer type which can be formatted as a number.
+        /// Unlike std::is_integral it also covers 128-bit integers, regardless of the strict or GNU mode of the standard library.
+        template<typename T>
+        struct IsInteger : std::is_integral<T> {};
+
+        template<typename T>
+        struct IsSignedInteger : std::is_signed<T> {};
+
+        template<typename T>
+        struct MakeUnsigned : std::make_unsigned<T> {};
+
+#ifdef STRINGBUILDER_SUPPORTS_INT128
+        template<> struct IsInteger<Int128> : std::true_type {};
+        template<> struct IsInteger<UInt128> : std::true_type {};
+        template<> struct IsSignedInteger<Int128> : std::true_type {};
+        template<> struct MakeUnsigned<Int128> { using type = UInt128; };
+        template<> struct MakeUnsigned<UInt128> { using type = UInt128; };
+
+        /// Unsigned integer type used for encoding of the integer type IntegerT.
+        /// Types narrower than 32 bits are encoded in 32-bit arithmetic, which is at least as fast as the narrow one.
+        template<typename IntegerT>
+        using DecimalUInt = typename std::conditional<sizeof(IntegerT) <= sizeof(uint32_t), uint32_t,
+            typename std::conditional<sizeof(IntegerT) <= sizeof(uint64_t), uint64_t, UInt128>::type>::type;
+#else
+        /// Unsigned integer type used for encoding of the integer type IntegerT.
+        /// Types narrower than 32 bits are encoded in 32-bit arithmetic, which is at least as fast as the narrow one.
+        template<typename IntegerT>
+        using DecimalUInt = typename std::conditional<sizeof(IntegerT) <= sizeof(uint32_t), uint32_t, uint64_t>::type;
+#endif
+
+        /// Gets the maximal number of characters of a decimal representation of IntegerT, including the minus sign.
+        template<typename IntegerT>
+        constexpr size_t maxDecimalWidth() noexcept
+        {
+            return std::numeric_limits<IntegerT>::digits10 + 1 + (std::is_signed<IntegerT>::value ? 1 : 0);
+        }
+
+#ifdef STRINGBUILDER_SUPPORTS_INT128
+        // std::numeric_limits is not specialized for 128-bit integers in the strict mode of the standard library.
+        template<> constexpr size_t maxDecimalWidth<Int128>() noexcept { return 40; }
+        template<> constexpr size_t maxDecimalWidth<UInt128>() noexcept { return 39; }
+#endif
+
+        template<typename IntegerT>
+        constexpr bool isNegative(IntegerT v) noexcept
+        {
+            return IsSignedInteger<IntegerT>::value && v < IntegerT{};
+        }
+
+        /// Gets the magnitude of an integer as an unsigned number (well defined also for the minimal value of a signed type).
+        template<typename IntegerT>
+        constexpr DecimalUInt<IntegerT> absoluteValue(IntegerT v) noexcept
+        {
+            return isNegative(v) ? DecimalUInt<IntegerT>{0} - static_cast<DecimalUInt<IntegerT>>(v) : static_cast<DecimalUInt<IntegerT>>(v);
+        }
+
+        /// Gets the index of the most significant set bit, i.e. floor(log2(v)). The argument must not be zero.
+        inline unsigned log2Floor(uint32_t v) noexcept
+        {
+            assert(v != 0);
+#if defined(__GNUC__)
+            return 31u - static_cast<unsigned>(__builtin_clz(v));
+#elif defined(_MSC_VER)
+            unsigned long index;
+            _BitScanReverse(&index, v);
+            return static_cast<unsigned>(index);
+#else
+            unsigned index = 0;
+            while (v >>= 1) ++index;
+            return index;
+#endif
+        }
+
+        /// Gets the index of the most significant set bit, i.e. floor(log2(v)). The argument must not be zero.
+        inline unsigned log2Floor(uint64_t v) noexcept
+        {
+            assert(v != 0);
+#if defined(__GNUC__)
+            return 63u - static_cast<unsigned>(__builtin_clzll(v));
+#elif defined(_MSC_VER) && defined(_M_X64)
+            unsigned long index;
+            _BitScanReverse64(&index, v);
+            return static_cast<unsigned>(index);
+#else
+            unsigned index = 0;
+            while (v >>= 1) ++index;
+            return index;
+#endif
+        }
+
+        template<typename Dummy = void>
+        struct PowersOf10
+        {
+            static const uint64_t table[20];
+        };
+
+        template<typename Dummy>
+        const uint64_t PowersOf10<Dummy>::table[20] = {
+            1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+            10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull, 1000000000000000ull,
+            10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull };
+
+        /// Gets the number of decimal digits of an unsigned integer (1 for zero).
+        /// The estimate of log10 comes from the bit-scan (1233/4096 ~ log10(2)) and is corrected by a single comparison, without any loop.
+        inline unsigned countDecimalDigits(uint64_t v) noexcept
+        {
+            v |= 1; // Does not affect the result, as the powers of 10 are even, but makes zero a valid argument.
+            const unsigned t = (log2Floor(v) + 1) * 1233 >> 12;
+            return t + 1 - static_cast<unsigned>(v < PowersOf10<>::table[t]);
+        }
+
+        /// Gets the number of decimal digits of an unsigned integer (1 for zero).
+        inline unsigned countDecimalDigits(uint32_t v) noexcept
+        {
+            v |= 1;
+            const unsigned t = (log2Floor(v) + 1) * 1233 >> 12;
+            return t + 1 - static_cast<unsigned>(v < PowersOf10<>::table[t]);
+        }
+
+#ifdef STRINGBUILDER_SUPPORTS_INT128
+        /// Gets the index of the most significant set bit, i.e. floor(log2(v)). The argument must not be zero.
+        inline unsigned log2Floor(UInt128 v) noexcept
+        {
+            const auto upper = static_cast<uint64_t>(v >> 64);
+            return upper != 0 ? 64 + log2Floor(upper) : log2Floor(static_cast<uint64_t>(v));
+        }
+
+        /// Gets the number of decimal digits of an unsigned integer (1 for zero).
+        inline unsigned countDecimalDigits(UInt128 v) noexcept
+        {
+            if (static_cast<uint64_t>(v >> 64) == 0)
+                return countDecimalDigits(static_cast<uint64_t>(v));
+            const unsigned t = (log2Floor(v) + 1) * 1233 >> 12;
+            const UInt128 powerOf10 = t < 20 ? UInt128{PowersOf10<>::table[t]} : UInt128{PowersOf10<>::table[t - 19]} * PowersOf10<>::table[19];
+            return t + 1 - static_cast<unsigned>(v < powerOf10);
+        }
+#endif
+
+        template<size_t MaxSize, typename SB, typename EncoderT>
+        void appendEncoded(SB& sb, size_t size, EncoderT&& encoder, std::false_type /*claim may refuse*/)
+        {
+            encoder(sb.claim(size));
+        }
+
+        template<size_t MaxSize, typename SB, typename EncoderT>
+        void appendEncoded(SB& sb, size_t size, EncoderT&& encoder, std::true_type /*claim may refuse*/)
+        {
+            if (typename SB::char_type* const claimed = sb.claim(size)) {
+                encoder(claimed);
+            }
+            else {
+                typename SB::char_type buffer[MaxSize];
+                encoder(buffer);
+                sb.append(buffer, size);
+            }
+        }
+
+        /// Claims exactly `size` characters in the string builder and lets the `encoder` fill them in (in forward order).
+        /// If the builder refuses the claim (an inplace_stringbuilder with a clipping overflow policy), the characters are
+        /// encoded into a temporary buffer of MaxSize characters and appended in a regular way, so the overflow policy is honored.
+        /// The temporary buffer is compiled in only for the builders whose claim() may refuse.
+        template<size_t MaxSize, typename SB, typename EncoderT>
+        void appendEncoded(SB& sb, size_t size, EncoderT&& encoder)
+        {
+            assert(size <= MaxSize);
+            appendEncoded<MaxSize>(sb, size, std::forward<EncoderT>(encoder), std::integral_constant<bool, SB::claim_may_refuse>{});
+        }
+
+        /// Writes the decimal digits of an unsigned integer backwards, so that the least significant digit lands just before `end`.
+        /// Two digits are produced per division using the DecimalDigitPairs table.
+        /// Returns the pointer to the most significant digit.
+        template<typename CharT, typename UIntT>
+        CharT* encodeDecimalBackward(CharT* end, UIntT v) noexcept
+        {
+            static_assert(std::is_unsigned<UIntT>::value, "Decimal encoder works on unsigned integers only");
+            const char* const pairs = DecimalDigitPairs<>::table;
+            while (v >= 100) {
+                const auto i = static_cast<size_t>(v % 100) * 2;
+                v /= 100;
+                *(--end) = static_cast<CharT>(pairs[i + 1]);
+                *(--end) = static_cast<CharT>(pairs[i]);
+            }
+            if (v >= 10) {
+                const auto i = static_cast<size_t>(v) * 2;
+                *(--end) = static_cast<CharT>(pairs[i + 1]);
+                *(--end) = static_cast<CharT>(pairs[i]);
+            }
+            else {
+                *(--end) = static_cast<CharT>('0' + static_cast<char>(v));
+            }
+            return end;
+        }
+
+        /// Writes exactly Width least significant decimal digits of an unsigned integer (including leading zeros) to dst[0..Width).
+        /// The recursion unrolls into a straight sequence of stores of digit pairs, free of branches.
+        template<size_t Width>
+        struct FixedDecimalEncoder
+        {
+            template<typename CharT, typename UIntT>
+            static void encode(CharT* dst, UIntT v) noexcept
+            {
+                const char* const pairs = DecimalDigitPairs<>::table;
+                const auto i = static_cast<size_t>(v % 100) * 2;
+                dst[Width - 1] = static_cast<CharT>(pairs[i + 1]);
+                dst[Width - 2] = static_cast<CharT>(pairs[i]);
+                FixedDecimalEncoder<Width - 2>::encode(dst, static_cast<UIntT>(v / 100));
+            }
+        };
+
+        template<>
+        struct FixedDecimalEncoder<1>
+        {
+            template<typename CharT, typename UIntT>
+            static void encode(CharT* dst, UIntT v) noexcept
+            {
+                dst[0] = static_cast<CharT>('0' + static_cast<char>(v % 10));
+            }
+        };
+
+        template<>
+        struct FixedDecimalEncoder<0>
+        {
+            template<typename CharT, typename UIntT>
+            static void encode(CharT*, UIntT) noexcept {}
+        };
+
+#ifdef STRINGBUILDER_SUPPORTS_INT128
+        /// Writes the decimal digits of a 128-bit unsigned integer backwards, so that the least significant digit lands just before `end`.
+        /// The value is split into limbs of 19 digits, so there are at most two 128-bit divisions and the digits come from the 64-bit encoder.
+        template<typename CharT>
+        CharT* encodeDecimalBackward(CharT* end, UInt128 v) noexcept
+        {
+            constexpr uint64_t limb = 10000000000000000000ull;
+            while (static_cast<uint64_t>(v >> 64) != 0) {
+                const UInt128 upper = v / limb;
+                end -= 19;
+                FixedDecimalEncoder<19>::encode(end, static_cast<uint64_t>(v - upper * limb));
+                v = upper;
+            }
+            return encodeDecimalBackward(end, static_cast<uint64_t>(v));
+        }
+#endif
+
+        /// Writes the decimal digits of an unsigned integer forwards, starting at `dst`, and returns the pointer past the last digit.
+        /// Up to `slack` characters past the returned pointer may be overwritten as well.
+        template<typename CharT, typename UIntT>
+        struct DecimalForwardEncoder
+        {
+            static constexpr size_t slack = 0;
+
+            static CharT* encode(CharT* dst, UIntT v) noexcept
+            {
+                CharT* const end = dst + countDecimalDigits(v);
+                encodeDecimalBackward(end, v);
+                return end;
+            }
+        };
+
+#ifdef STRINGBUILDER_LITTLE_ENDIAN
+        /// Converts a value below 10^8 into its 8 decimal digits (as numbers, not characters), one per byte, the most significant one in the lowest byte.
+        /// All the digits are computed at once in a 64-bit register (SWAR): the value is split into halves of 4 digits, then quarters of 2 digits and finally single digits,
+        /// where each division by a constant is a multiplication and a shift with a mask, exact in the range of values it is applied to.
+        inline uint64_t splitDecimalDigits8(uint32_t v) noexcept
+        {
+            const uint64_t x = v;
+            const uint64_t upper4 = (x * 109951163) >> 40;
+            const uint64_t halves = upper4 | ((x - upper4 * 10000) << 32);
+            const uint64_t upper2 = ((halves * 10486) >> 20) & 0x0000007F0000007Full;
+            const uint64_t quarters = upper2 | ((halves - upper2 * 100) << 16);
+            const uint64_t upper1 = ((quarters * 103) >> 10) & 0x000F000F000F000Full;
+            return upper1 | ((quarters - upper1 * 10) << 8);
+        }
+
+        /// Narrow characters are written 8 digits at a time: the leading group of 1-8 digits and then the full groups of exactly 8 digits.
+        template<typename UIntT>
+        struct DecimalForwardEncoder<char, UIntT>
+        {
+            static constexpr size_t slack = 7;
+
+            static char* encode(char* dst, UIntT v) noexcept
+            {
+                if (v < 100000000u)
+                    return encodeLeading(dst, static_cast<uint32_t>(v));
+                if (sizeof(UIntT) <= sizeof(uint32_t) || v < 10000000000000000ull) {
+                    dst = encodeLeading(dst, static_cast<uint32_t>(v / 100000000u));
+                    return encodeFull(dst, static_cast<uint32_t>(v % 100000000u));
+                }
+                const uint64_t lower16 = static_cast<uint64_t>(v % 10000000000000000ull);
+                dst = encodeLeading(dst, static_cast<uint32_t>(v / 10000000000000000ull));
+                dst = encodeFull(dst, static_cast<uint32_t>(lower16 / 100000000u));
+                return encodeFull(dst, static_cast<uint32_t>(lower16 % 100000000u));
+            }
+
+        private:
+            static char* encodeLeading(char* dst, uint32_t v) noexcept
+            {
+                const unsigned digitCount = countDecimalDigits(v);
+                const uint64_t chars = (splitDecimalDigits8(v) | 0x3030303030303030ull) >> (8 * (8 - digitCount));
+                std::memcpy(dst, &chars, sizeof(chars));
+                return dst + digitCount;
+            }
+
+            static char* encodeFull(char* dst, uint32_t v) noexcept
+            {
+                const uint64_t chars = splitDecimalDigits8(v) | 0x3030303030303030ull;
+                std::memcpy(dst, &chars, sizeof(chars));
+                return dst + 8;
+            }
+        };
+
+#ifdef STRINGBUILDER_SUPPORTS_INT128
+        template<>
+        struct DecimalForwardEncoder<char, UInt128>
+        {
+            static constexpr size_t slack = 0;
+
+            static char* encode(char* dst, UInt128 v) noexcept
+            {
+                char* const end = dst + countDecimalDigits(v);
+                encodeDecimalBackward(end, v);
+                return end;
+            }
+        };
+#endif
+#endif
+    }
+
+    template<typename SB, typename IntegerT>
+    struct sb_appender<SB, IntegerT, typename std::enable_if<
+        detail::IsInteger<IntegerT>::value && !::std::is_same<IntegerT, typename SB::char_type>::value >::type>
+    {
+        void operator()(SB& sb, IntegerT iv) const
+        {
+            using char_type = typename SB::char_type;
+            const auto magnitude = detail::absoluteValue(iv);
+            const bool negative = detail::isNegative(iv);
+            const size_t size = detail::countDecimalDigits(magnitude) + (negative ? 1 : 0);
+            detail::appendEncoded<detail::maxDecimalWidth<IntegerT>()>(sb, size, [=](char_type* dst) {
+                detail::encodeDecimalBackward(dst + size, magnitude);
+                if (negative) {
+                    *dst = '-';
+                }
+            });
+        }
+    };
+
+    /// A range of integers is encoded in batches: each one claims space for the worst case of many integers at once, so that there is
+    /// a single capacity check per batch instead of two per integer, and gives back the unused rest.
+    template<typename SB, typename IntegerT>
+    struct sb_range_appender<SB, IntegerT, typename std::enable_if<
+        detail::IsInteger<IntegerT>::value && !::std::is_same<IntegerT, typename SB::char_type>::value >::type>
+    {
+        static constexpr size_t batch_size = 256;
+
+        template<typename ForwardIt>
+        void operator()(SB& sb, ForwardIt first, ForwardIt last, const typename SB::char_type* separator, size_t separatorSize) const
+        {
+            using char_type = typename SB::char_type;
+            using Encoder = detail::DecimalForwardEncoder<char_type, detail::DecimalUInt<IntegerT>>;
+            const size_t maxStride = separatorSize + detail::maxDecimalWidth<IntegerT>();
+            const size_t minClaim = maxStride + Encoder::slack;
+
+            for (auto it = first; it != last;) {
+                const auto claimed = sb.claim(minClaim, batch_size * maxStride + Encoder::slack);
+                char_type* dst = claimed.first;
+                char_type* const dstEnd = claimed.first + claimed.second;
+                for (; it != last && static_cast<size_t>(dstEnd - dst) >= minClaim; ++it) {
+                    if (it != first) {
+                        for (size_t i = 0; i < separatorSize; ++i) {
+                            *(dst++) = separator[i];
+                        }
+                    }
+                    const IntegerT iv = *it;
+                    if (detail::isNegative(iv)) {
+                        *(dst++) = '-';
+                    }
+                    dst = Encoder::encode(dst, detail::absoluteValue(iv));
+                }
+                sb.reclaim(static_cast<size_t>(dstEnd - dst));
+            }
+        }
+    };
+
+
+    /// Integer formatted in a numeral system of radix 2^BitsPerDigit (binary, octal or hexadecimal), created with bin(), oct() or hex().
+    /// Negative numbers are formatted as their two's complement representation in the width of IntegerT (like "%x" of printf() does).
+    /// At least MinWidth digits are produced, padded with leading zeros.
+    /// Prefix prepends the value with "0b", "0" or "0x" respectively ("0B" and "0X" if Upper is set).
+    /// Like "%#o" of printf() does, the octal "0" is not prepended when the leading digit is a zero already, e.g. oct<0, true>(0) gives "0".
+    template<unsigned BitsPerDigit, typename IntegerT, size_t MinWidth = 0, bool Upper = false, bool Prefix = false>
+    struct radix_int_t
+    {
+        static_assert(detail::IsInteger<IntegerT>::value && !std::is_same<IntegerT, bool>::value, "Only integers can be formatted in binary, octal or hexadecimal system");
+        static_assert(BitsPerDigit >= 1 && BitsPerDigit <= 4, "Unsupported radix");
+
+        /// Number of characters of the prefix.
+        static constexpr size_t prefix_size = !Prefix ? 0 : BitsPerDigit == 3 ? 1 : 2;
+        /// Maximal number of digits of a value of IntegerT.
+        static constexpr size_t max_digits = (8 * sizeof(IntegerT) + BitsPerDigit - 1) / BitsPerDigit;
+        /// Maximal number of characters of a formatted value.
+        static constexpr size_t max_size = prefix_size + (MinWidth > max_digits ? MinWidth : max_digits);
+
+        IntegerT value;
+    };
+
+    template<typename IntegerT, size_t MinWidth = 0, bool Upper = false, bool Prefix = false>
+    using bin_t = radix_int_t<1, IntegerT, MinWidth, Upper, Prefix>;
+
+    template<typename IntegerT, size_t MinWidth = 0, bool Prefix = false>
+    using oct_t = radix_int_t<3, IntegerT, MinWidth, false, Prefix>;
+
+    template<typename IntegerT, size_t MinWidth = 0, bool Upper = false, bool Prefix = false>
+    using hex_t = radix_int_t<4, IntegerT, MinWidth, Upper, Prefix>;
+
+    /// Formats an integer in the binary system, e.g. bin<8>(5) gives "00000101".
+    template<size_t MinWidth = 0, bool Prefix = false, typename IntegerT>
+    constexpr bin_t<IntegerT, MinWidth, false, Prefix> bin(IntegerT v) noexcept { return { v }; }
+
+    /// Formats an integer in the octal system, e.g. oct<0, true>(8) gives "010".
+    template<size_t MinWidth = 0, bool Prefix = false, typename IntegerT>
+    constexpr oct_t<IntegerT, MinWidth, Prefix> oct(IntegerT v) noexcept { return { v }; }
+
+    /// Formats an integer in the hexadecimal system, e.g. hex<4, true>(255) gives "00FF" and hex<0, false, true>(255) gives "0xff".
+    template<size_t MinWidth = 0, bool Upper = false, bool Prefix = false, typename IntegerT>
+    constexpr hex_t<IntegerT, MinWidth, Upper, Prefix> hex(IntegerT v) noexcept { return { v }; }
+
+    namespace detail
+    {
+        /// Fills the range [begin, end) with the least significant digits of an unsigned integer in the radix 2^BitsPerDigit.
+        /// Digits are taken one at a time from a 16-character table, so the range is padded with zeros once the value runs out of digits.
+        template<unsigned BitsPerDigit, bool Upper, typename CharT, typename UIntT>
+        void encodeRadixBackward(CharT* begin, CharT* end, UIntT v) noexcept
+        {
+            const char* const digits = Upper ? "0123456789ABCDEF" : "0123456789abcdef";
+            constexpr UIntT mask = (UIntT{1} << BitsPerDigit) - 1;
+            while (end != begin) {
+                *(--end) = static_cast<CharT>(digits[v & mask]);
+                v >>= BitsPerDigit;
+            }
+        }
+    }
+
+    template<typename SB, unsigned BitsPerDigit, typename IntegerT, size_t MinWidth, bool Upper, bool Prefix>
+    struct sb_appender<SB, radix_int_t<BitsPerDigit, IntegerT, MinWidth, Upper, Prefix>>
+    {
+        using formatted_type = radix_int_t<BitsPerDigit, IntegerT, MinWidth, Upper, Prefix>;
+
+        void operator()(SB& sb, const formatted_type& ri) const
+        {
+            using char_type = typename SB::char_type;
+            using UInt = detail::DecimalUInt<IntegerT>;
+            const UInt v = static_cast<typename detail::MakeUnsigned<IntegerT>::type>(ri.value);
+            const size_t digitCount = detail::log2Floor(v | 1) / BitsPerDigit + 1;
+            const bool leadingZero = v == 0 || digitCount < MinWidth;
+            const size_t prefixSize = BitsPerDigit == 3 && leadingZero ? 0 : formatted_type::prefix_size;
+            const size_t size = prefixSize + (digitCount > MinWidth ? digitCount : MinWidth);
+            detail::appendEncoded<formatted_type::max_size>(sb, size, [=](char_type* dst) {
+                detail::encodeRadixBackward<BitsPerDigit, Upper>(dst + prefixSize, dst + size, v);
+                if (prefixSize > 0) {
+                    dst[0] = '0';
+                    if (BitsPerDigit != 3) {
+                        dst[1] = static_cast<char_type>(BitsPerDigit == 4 ? (Upper ? 'X' : 'x') : (Upper ? 'B' : 'b'));
+                    }
+                }
+            });
+        }
+    };
+
+
+    /// Integer formatted to exactly Width characters, right-aligned and padded with Fill characters, created with padded().
+    /// With the default Fill of '0' the minus sign leads the padding (like "%06d" of printf() does), otherwise it precedes the first digit.
+    /// The value must fit in Width characters, otherwise only its Width least significant digits are written (and the sign may be lost).
+    template<size_t Width, char Fill, typename IntegerT>
+    struct padded_int_t
+    {
+        static_assert(Width > 0, "Width must be greater than zero");
+        static_assert(detail::IsInteger<IntegerT>::value && !std::is_same<IntegerT, bool>::value, "Only integers can be padded");
+
+        /// Number of characters of a formatted value.
+        static constexpr size_t max_size = Width;
+
+        IntegerT value;
+    };
+
+    /// Formats an integer to exactly Width characters, e.g. padded<6>(-42) gives "-00042" and padded<6, ' '>(-42) gives "   -42".
+    template<size_t Width, char Fill = '0', typename IntegerT>
+    constexpr padded_int_t<Width, Fill, IntegerT> padded(IntegerT v) noexcept { return { v }; }
+
+    template<typename SB, size_t Width, char Fill, typename IntegerT>
+    struct sb_appender<SB, padded_int_t<Width, Fill, IntegerT>>
+    {
+        void operator()(SB& sb, const padded_int_t<Width, Fill, IntegerT>& pi) const
+        {
+            using char_type = typename SB::char_type;
+            const auto magnitude = detail::absoluteValue(pi.value);
+            const bool negative = detail::isNegative(pi.value);
+            assert(detail::countDecimalDigits(magnitude) + (negative ? 1 : 0) <= Width && "The value does not fit in the padded width");
+
+            detail::appendEncoded<Width>(sb, Width, [=](char_type* dst) {
+                detail::FixedDecimalEncoder<Width>::encode(dst, magnitude);
+                if (Fill == '0') {
+                    // The leading digit is a padding zero whenever a negative value fits in Width characters.
+                    dst[0] = negative ? static_cast<char_type>('-') : dst[0];
+                }
+                else {
+                    const size_t digitCount = detail::countDecimalDigits(magnitude);
+                    size_t padCount = Width > digitCount ? Width - digitCount : 0;
+                    if (negative && padCount > 0) {
+                        dst[--padCount] = '-';
+                    }
+                    for (size_t i = 0; i < padCount; ++i) {
+                        dst[i] = static_cast<char_type>(Fill);
+                    }
+                }
+            });
+        }
+    };
+
+
+    /// Integer formatted in decimal with its digits grouped by three, created with grouped().
+    template<typename IntegerT, typename SeparatorT>
+    struct grouped_int_t
+    {
+        static_assert(detail::IsInteger<IntegerT>::value && !std::is_same<IntegerT, bool>::value, "Only integers can be grouped");
+
+        /// Maximal number of digits of a formatted value.
+        static constexpr size_t max_digits = detail::maxDecimalWidth<IntegerT>() - (detail::IsSignedInteger<IntegerT>::value ? 1 : 0);
+        /// Maximal number of characters of a formatted value, including the separators and the minus sign.
+        static constexpr size_t max_size = detail::maxDecimalWidth<IntegerT>() + (max_digits - 1) / 3;
+
+        IntegerT value;
+        SeparatorT separator;
+    };
+
+    /// Formats an integer with a separator between groups of three digits, e.g. grouped(-1234567) gives "-1,234,567".
+    /// No locale is consulted: the separator is given explicitly, e.g. grouped(1234567, ' ') gives "1 234 567".
+    template<typename IntegerT, typename SeparatorT = char>
+    constexpr grouped_int_t<IntegerT, SeparatorT> grouped(IntegerT v, SeparatorT separator = ',') noexcept { return { v, separator }; }
+
+    template<typename SB, typename IntegerT, typename SeparatorT>
+    struct sb_appender<SB, grouped_int_t<IntegerT, SeparatorT>>
+    {
+        void operator()(SB& sb, const grouped_int_t<IntegerT, SeparatorT>& gi) const
+        {
+            using char_type = typename SB::char_type;
+            const auto magnitude = detail::absoluteValue(gi.value);
+            const bool negative = detail::isNegative(gi.value);
+            const size_t digitCount = detail::countDecimalDigits(magnitude);
+            const size_t size = digitCount + (digitCount - 1) / 3 + (negative ? 1 : 0);
+            const auto separator = static_cast<char_type>(gi.separator);
+
+            detail::appendEncoded<grouped_int_t<IntegerT, SeparatorT>::max_size>(sb, size, [=](char_type* dst) {
+                char_type* end = dst + size;
+                auto v = magnitude;
+                // Every group but the leading one has exactly three digits, so they are written with the fixed-width encoder.
+                for (size_t groupCount = (digitCount - 1) / 3; groupCount > 0; --groupCount) {
+                    const auto upper = static_cast<decltype(v)>(v / 1000);
+                    end -= 3;
+                    detail::FixedDecimalEncoder<3>::encode(end, static_cast<uint32_t>(v - upper * 1000));
+                    *(--end) = separator;
+                    v = upper;
+                }
+                end = detail::encodeDecimalBackward(end, v);
+                if (negative) {
+                    *(--end) = '-';
+                }
+            });
+        }
+    };
+
+
+    /// Compile-time integers are appended as their values.
+    template<typename SB, typename IntegralT, IntegralT V>
+    struct sb_appender<SB, std::integral_constant<IntegralT, V>>
+    {
+        void operator()(SB& sb, std::integral_constant<IntegralT, V>) const
+        {
+            sb.append(V);
+        }
+    };
+
+#if __cpp_nontype_template_parameter_auto
+    /// Compile-time integer, e.g. num<404>, which can be stringified by make_string() in compile-time.
+    template<auto V>
+    constexpr std::integral_constant<decltype(V), V> num{};
+#endif
+
+
+    namespace detail
+    {
+        /// Powers of 5 normalized to 125 significant bits (5^i, i < 326) and their reciprocals scaled by 2^(bitlength(5^i) - 1 + 125) and rounded up (i < 342),
+        /// stored as { low, high } halves of 128-bit numbers. These are the tables of the Ryu algorithm (Ulf Adams, "Ryu: Fast Float-to-String Conversion", PLDI 2018).
+        template<typename Dummy = void>
+        struct DoublePow5Split
+        {
+            static const uint64_t table[326][2];
+        };
+
+        template<typename Dummy>
+        const uint64_t DoublePow5Split<Dummy>::table[326][2] = {
+            { 0x0000000000000000u, 0x1000000000000000u }, { 0x0000000000000000u, 0x1400000000000000u },
+            { 0x0000000000000000u, 0x1900000000000000u }, { 0x0000000000000000u, 0x1f40000000000000u },
+            { 0x0000000000000000u, 0x1388000000000000u }, { 0x0000000000000000u, 0x186a000000000000u },
+            { 0x0000000000000000u, 0x1e84800000000000u }, { 0x0000000000000000u, 0x1312d00000000000u },
+            { 0x0000000000000000u, 0x17d7840000000000u }, { 0x0000000000000000u, 0x1dcd650000000000u },
+            { 0x0000000000000000u, 0x12a05f2000000000u }, { 0x0000000000000000u, 0x174876e800000000u },
+            { 0x0000000000000000u, 0x1d1a94a200000000u }, { 0x0000000000000000u, 0x12309ce540000000u },
+            { 0x0000000000000000u, 0x16bcc41e90000000u }, { 0x0000000000000000u, 0x1c6bf52634000000u },
+            { 0x0000000000000000u, 0x11c37937e0800000u }, { 0x0000000000000000u, 0x16345785d8a00000u },
+            { 0x0000000000000000u, 0x1bc16d674ec80000u }, { 0x0000000000000000u, 0x1158e460913d0000u },
+            { 0x0000000000000000u, 0x15af1d78b58c4000u }, { 0x0000000000000000u, 0x1b1ae4d6e2ef5000u },
+            { 0x0000000000000000u, 0x10f0cf064dd59200u }, { 0x0000000000000000u, 0x152d02c7e14af680u },
+            { 0x0000000000000000u, 0x1a784379d99db420u }, { 0x0000000000000000u, 0x108b2a2c28029094u },
+            { 0x0000000000000000u, 0x14adf4b7320334b9u }, { 0x4000000000000000u, 0x19d971e4fe8401e7u },
+            { 0x8800000000000000u, 0x1027e72f1f128130u }, { 0xaa00000000000000u, 0x1431e0fae6d7217cu },
+            { 0xd480000000000000u, 0x193e5939a08ce9dbu }, { 0xc9a0000000000000u, 0x1f8def8808b02452u },
+            { 0xbe04000000000000u, 0x13b8b5b5056e16b3u }, { 0xad85000000000000u, 0x18a6e32246c99c60u },
+            { 0xd8e6400000000000u, 0x1ed09bead87c0378u }, { 0x878fe80000000000u, 0x13426172c74d822bu },
+            { 0x6973e20000000000u, 0x1812f9cf7920e2b6u }, { 0x03d0da8000000000u, 0x1e17b84357691b64u },
+            { 0x8262889000000000u, 0x12ced32a16a1b11eu }, { 0x22fb2ab400000000u, 0x178287f49c4a1d66u },
+            { 0xabb9f56100000000u, 0x1d6329f1c35ca4bfu }, { 0xcb54395ca0000000u, 0x125dfa371a19e6f7u },
+            { 0xbe2947b3c8000000u, 0x16f578c4e0a060b5u }, { 0x2db399a0ba000000u, 0x1cb2d6f618c878e3u },
+            { 0xfc90400474400000u, 0x11efc659cf7d4b8du }, { 0x7bb4500591500000u, 0x166bb7f0435c9e71u },
+            { 0xdaa16406f5a40000u, 0x1c06a5ec5433c60du }, { 0xa8a4de8459868000u, 0x118427b3b4a05bc8u },
+            { 0xd2ce16256fe82000u, 0x15e531a0a1c872bau }, { 0x87819baecbe22800u, 0x1b5e7e08ca3a8f69u },
+            { 0xf4b1014d3f6d5900u, 0x111b0ec57e6499a1u }, { 0x71dd41a08f48af40u, 0x1561d276ddfdc00au },
+            { 0x0e549208b31adb10u, 0x1aba4714957d300du }, { 0x28f4db456ff0c8eau, 0x10b46c6cdd6e3e08u },
+            { 0x33321216cbecfb24u, 0x14e1878814c9cd8au }, { 0xbffe969c7ee839edu, 0x1a19e96a19fc40ecu },
+            { 0xf7ff1e21cf512434u, 0x105031e2503da893u }, { 0xf5fee5aa43256d41u, 0x14643e5ae44d12b8u },
+            { 0x337e9f14d3eec892u, 0x197d4df19d605767u }, { 0x005e46da08ea7ab6u, 0x1fdca16e04b86d41u },
+            { 0xa03aec4845928cb2u, 0x13e9e4e4c2f34448u }, { 0xc849a75a56f72fdeu, 0x18e45e1df3b0155au },
+            { 0x7a5c1130ecb4fbd6u, 0x1f1d75a5709c1ab1u }, { 0xec798abe93f11d65u, 0x13726987666190aeu },
+            { 0xa797ed6e38ed64bfu, 0x184f03e93ff9f4dau }, { 0x517de8c9c728bdefu, 0x1e62c4e38ff87211u },
+            { 0xd2eeb17e1c7976b5u, 0x12fdbb0e39fb474au }, { 0x87aa5ddda397d462u, 0x17bd29d1c87a191du },
+            { 0xe994f5550c7dc97bu, 0x1dac74463a989f64u }, { 0x11fd195527ce9dedu, 0x128bc8abe49f639fu },
+            { 0xd67c5faa71c24568u, 0x172ebad6ddc73c86u }, { 0x8c1b77950e32d6c2u, 0x1cfa698c95390ba8u },
+            { 0x57912abd28dfc639u, 0x121c81f7dd43a749u }, { 0xad75756c7317b7c8u, 0x16a3a275d494911bu },
+            { 0x98d2d2c78fdda5bau, 0x1c4c8b1349b9b562u }, { 0x9f83c3bcb9ea8794u, 0x11afd6ec0e14115du },
+            { 0x0764b4abe8652979u, 0x161bcca7119915b5u }, { 0x493de1d6e27e73d7u, 0x1ba2bfd0d5ff5b22u },
+            { 0x6dc6ad264d8f0866u, 0x1145b7e285bf98f5u }, { 0xc938586fe0f2ca80u, 0x159725db272f7f32u },
+            { 0x7b866e8bd92f7d20u, 0x1afcef51f0fb5effu }, { 0xad34051767bdae34u, 0x10de1593369d1b5fu },
+            { 0x9881065d41ad19c1u, 0x15159af804446237u }, { 0x7ea147f492186032u, 0x1a5b01b605557ac5u },
+            { 0x6f24ccf8db4f3c1fu, 0x1078e111c3556cbbu }, { 0x4aee003712230b27u, 0x14971956342ac7eau },
+            { 0xdda98044d6abcdf0u, 0x19bcdfabc13579e4u }, { 0x0a89f02b062b60b6u, 0x10160bcb58c16c2fu },
+            { 0xcd2c6c35c7b638e4u, 0x141b8ebe2ef1c73au }, { 0x8077874339a3c71du, 0x1922726dbaae3909u },
+            { 0xe0956914080cb8e4u, 0x1f6b0f092959c74bu }, { 0x6c5d61ac8507f38eu, 0x13a2e965b9d81c8fu },
+            { 0x4774ba17a649f072u, 0x188ba3bf284e23b3u }, { 0x1951e89d8fdc6c8fu, 0x1eae8caef261aca0u },
+            { 0x0fd3316279e9c3d9u, 0x132d17ed577d0be4u }, { 0x13c7fdbb186434cfu, 0x17f85de8ad5c4eddu },
+            { 0x58b9fd29de7d4203u, 0x1df67562d8b36294u }, { 0xb7743e3a2b0e4942u, 0x12ba095dc7701d9cu },
+            { 0xe5514dc8b5d1db92u, 0x17688bb5394c2503u }, { 0xdea5a13ae3465277u, 0x1d42aea2879f2e44u },
+            { 0x0b2784c4ce0bf38au, 0x1249ad2594c37cebu }, { 0xcdf165f6018ef06du, 0x16dc186ef9f45c25u },
+            { 0x416dbf7381f2ac88u, 0x1c931e8ab871732fu }, { 0x88e497a83137abd5u, 0x11dbf316b346e7fdu },
+            { 0xeb1dbd923d8596cau, 0x1652efdc6018a1fcu }, { 0x25e52cf6cce6fc7du, 0x1be7abd3781eca7cu },
+            { 0x97af3c1a40105dceu, 0x1170cb642b133e8du }, { 0xfd9b0b20d0147542u, 0x15ccfe3d35d80e30u },
+            { 0x3d01cde904199292u, 0x1b403dcc834e11bdu }, { 0x462120b1a28ffb9bu, 0x1108269fd210cb16u },
+            { 0xd7a968de0b33fa82u, 0x154a3047c694fddbu }, { 0xcd93c3158e00f923u, 0x1a9cbc59b83a3d52u },
+            { 0xc07c59ed78c09bb6u, 0x10a1f5b813246653u }, { 0xb09b7068d6f0c2a3u, 0x14ca732617ed7fe8u },
+            { 0xdcc24c830cacf34cu, 0x19fd0fef9de8dfe2u }, { 0xc9f96fd1e7ec180fu, 0x103e29f5c2b18bedu },
+            { 0x3c77cbc661e71e13u, 0x144db473335deee9u }, { 0x8b95beb7fa60e598u, 0x1961219000356aa3u },
+            { 0x6e7b2e65f8f91efeu, 0x1fb969f40042c54cu }, { 0xc50cfcffbb9bb35fu, 0x13d3e2388029bb4fu },
+            { 0xb6503c3faa82a037u, 0x18c8dac6a0342a23u }, { 0xa3e44b4f95234844u, 0x1efb1178484134acu },
+            { 0xe66eaf11bd360d2bu, 0x135ceaeb2d28c0ebu }, { 0xe00a5ad62c839075u, 0x183425a5f872f126u },
+            { 0x980cf18bb7a47493u, 0x1e412f0f768fad70u }, { 0x5f0816f752c6c8dcu, 0x12e8bd69aa19cc66u },
+            { 0xf6ca1cb527787b13u, 0x17a2ecc414a03f7fu }, { 0xf47ca3e2715699d7u, 0x1d8ba7f519c84f5fu },
+            { 0xf8cde66d86d62026u, 0x127748f9301d319bu }, { 0xf7016008e88ba830u, 0x17151b377c247e02u },
+            { 0xb4c1b80b22ae923cu, 0x1cda62055b2d9d83u }, { 0x50f91306f5ad1b65u, 0x12087d4358fc8272u },
+            { 0xe53757c8b318623fu, 0x168a9c942f3ba30eu }, { 0x9e852dbadfde7acfu, 0x1c2d43b93b0a8bd2u },
+            { 0xa3133c94cbeb0cc1u, 0x119c4a53c4e69763u }, { 0x8bd80bb9fee5cff1u, 0x16035ce8b6203d3cu },
+            { 0xaece0ea87e9f43eeu, 0x1b843422e3a84c8bu }, { 0x4d40c9294f238a75u, 0x1132a095ce492fd7u },
+            { 0x2090fb73a2ec6d12u, 0x157f48bb41db7bcdu }, { 0x68b53a508ba78856u, 0x1adf1aea12525ac0u },
+            { 0x417144725748b536u, 0x10cb70d24b7378b8u }, { 0x51cd958eed1ae283u, 0x14fe4d06de5056e6u },
+            { 0xe640faf2a8619b24u, 0x1a3de04895e46c9fu }, { 0xefe89cd7a93d00f7u, 0x1066ac2d5daec3e3u },
+            { 0xebe2c40d938c4134u, 0x14805738b51a74dcu }, { 0x26db7510f86f5181u, 0x19a06d06e2611214u },
+            { 0x9849292a9b4592f1u, 0x100444244d7cab4cu }, { 0xbe5b73754216f7adu, 0x1405552d60dbd61fu },
+            { 0xadf25052929cb598u, 0x1906aa78b912cba7u }, { 0x996ee4673743e2ffu, 0x1f485516e7577e91u },
+            { 0xffe54ec0828a6ddfu, 0x138d352e5096af1au }, { 0xbfdea270a32d0957u, 0x18708279e4bc5ae1u },
+            { 0x2fd64b0ccbf84badu, 0x1e8ca3185deb719au }, { 0x5de5eee7ff7b2f4cu, 0x1317e5ef3ab32700u },
+            { 0x755f6aa1ff59fb1fu, 0x17dddf6b095ff0c0u }, { 0x92b7454a7f3079e7u, 0x1dd55745cbb7ecf0u },
+            { 0x5bb28b4e8f7e4c30u, 0x12a5568b9f52f416u }, { 0xf29f2e22335ddf3cu, 0x174eac2e8727b11bu },
+            { 0xef46f9aac035570bu, 0x1d22573a28f19d62u }, { 0xd58c5c0ab8215667u, 0x123576845997025du },
+            { 0x4aef730d6629ac01u, 0x16c2d4256ffcc2f5u }, { 0x9dab4fd0bfb41701u, 0x1c73892ecbfbf3b2u },
+            { 0xa28b11e277d08e60u, 0x11c835bd3f7d784fu }, { 0x8b2dd65b15c4b1f9u, 0x163a432c8f5cd663u },
+            { 0x6df94bf1db35de77u, 0x1bc8d3f7b3340bfcu }, { 0xc4bbcf772901ab0au, 0x115d847ad000877du },
+            { 0x35eac354f34215cdu, 0x15b4e5998400a95du }, { 0x8365742a30129b40u, 0x1b221effe500d3b4u },
+            { 0xd21f689a5e0ba108u, 0x10f5535fef208450u }, { 0x06a742c0f58e894au, 0x1532a837eae8a565u },
+            { 0x4851137132f22b9du, 0x1a7f5245e5a2cebeu }, { 0xed32ac26bfd75b42u, 0x108f936baf85c136u },
+            { 0xa87f57306fcd3212u, 0x14b378469b673184u }, { 0xd29f2cfc8bc07e97u, 0x19e056584240fde5u },
+            { 0xa3a37c1dd7584f1eu, 0x102c35f729689eafu }, { 0x8c8c5b254d2e62e6u, 0x14374374f3c2c65bu },
+            { 0x6faf71eea079fb9fu, 0x1945145230b377f2u }, { 0x0b9b4e6a48987a87u, 0x1f965966bce055efu },
+            { 0x674111026d5f4c94u, 0x13bdf7e0360c35b5u }, { 0xc111554308b71fbau, 0x18ad75d8438f4322u },
+            { 0x7155aa93cae4e7a8u, 0x1ed8d34e547313ebu }, { 0x26d58a9c5ecf10c9u, 0x13478410f4c7ec73u },
+            { 0xf08aed437682d4fbu, 0x1819651531f9e78fu }, { 0xecada89454238a3au, 0x1e1fbe5a7e786173u },
+            { 0x73ec895cb4963664u, 0x12d3d6f88f0b3ce8u }, { 0x90e7abb3e1bbc3fdu, 0x1788ccb6b2ce0c22u },
+            { 0x352196a0da2ab4fdu, 0x1d6affe45f818f2bu }, { 0x0134fe24885ab11eu, 0x1262dfeebbb0f97bu },
+            { 0xc1823dadaa715d65u, 0x16fb97ea6a9d37d9u }, { 0x31e2cd19150db4bfu, 0x1cba7de5054485d0u },
+            { 0x1f2dc02fad2890f7u, 0x11f48eaf234ad3a2u }, { 0xa6f9303b9872b535u, 0x1671b25aec1d888au },
+            { 0x50b77c4a7e8f6282u, 0x1c0e1ef1a724eaadu }, { 0x5272adae8f199d91u, 0x1188d357087712acu },
+            { 0x670f591a32e004f6u, 0x15eb082cca94d757u }, { 0x40d32f60bf980633u, 0x1b65ca37fd3a0d2du },
+            { 0x4883fd9c77bf03e0u, 0x111f9e62fe44483cu }, { 0x5aa4fd0395aec4d8u, 0x156785fbbdd55a4bu },
+            { 0x314e3c447b1a760eu, 0x1ac1677aad4ab0deu }, { 0xded0e5aaccf089c9u, 0x10b8e0acac4eae8au },
+            { 0x96851f15802cac3bu, 0x14e718d7d7625a2du }, { 0xfc2666dae037d74au, 0x1a20df0dcd3af0b8u },
+            { 0x9d980048cc22e68eu, 0x10548b68a044d673u }, { 0x84fe005aff2ba032u, 0x1469ae42c8560c10u },
+            { 0xa63d8071bef6883eu, 0x198419d37a6b8f14u }, { 0xcfcce08e2eb42a4eu, 0x1fe52048590672d9u },
+            { 0x21e00c58dd309a70u, 0x13ef342d37a407c8u }, { 0x2a580f6f147cc10du, 0x18eb0138858d09bau },
+            { 0xb4ee134ad99bf150u, 0x1f25c186a6f04c28u }, { 0x7114cc0ec80176d2u, 0x137798f428562f99u },
+            { 0xcd59ff127a01d486u, 0x18557f31326bbb7fu }, { 0xc0b07ed7188249a8u, 0x1e6adefd7f06aa5fu },
+            { 0xd86e4f466f516e09u, 0x1302cb5e6f642a7bu }, { 0xce89e3180b25c98bu, 0x17c37e360b3d351au },
+            { 0x822c5bde0def3beeu, 0x1db45dc38e0c8261u }, { 0xf15bb96ac8b58575u, 0x1290ba9a38c7d17cu },
+            { 0x2db2a7c57ae2e6d2u, 0x1734e940c6f9c5dcu }, { 0x391f51b6d99ba086u, 0x1d022390f8b83753u },
+            { 0x03b3931248014454u, 0x1221563a9b732294u }, { 0x04a077d6da019569u, 0x16a9abc9424feb39u },
+            { 0x45c895cc9081fac3u, 0x1c5416bb92e3e607u }, { 0x8b9d5d9fda513cbau, 0x11b48e353bce6fc4u },
+            { 0xae84b507d0e58be8u, 0x1621b1c28ac20bb5u }, { 0x1a25e249c51eeee3u, 0x1baa1e332d728ea3u },
+            { 0xf057ad6e1b33554du, 0x114a52dffc679925u }, { 0x6c6d98c9a2002aa1u, 0x159ce797fb817f6fu },
+            { 0x4788fefc0a803549u, 0x1b04217dfa61df4bu }, { 0x0cb59f5d8690214eu, 0x10e294eebc7d2b8fu },
+            { 0xcfe30734e83429a1u, 0x151b3a2a6b9c7672u }, { 0x83dbc9022241340au, 0x1a6208b50683940fu },
+            { 0xb2695da15568c086u, 0x107d457124123c89u }, { 0x1f03b509aac2f0a7u, 0x149c96cd6d16cbacu },
+            { 0x26c4a24c1573acd1u, 0x19c3bc80c85c7e97u }, { 0x783ae56f8d684c03u, 0x101a55d07d39cf1eu },
+            { 0x16499ecb70c25f03u, 0x1420eb449c8842e6u }, { 0x9bdc067e4cf2f6c4u, 0x19292615c3aa539fu },
+            { 0x82d3081de02fb476u, 0x1f736f9b3494e887u }, { 0xb1c3e512ac1dd0c9u, 0x13a825c100dd1154u },
+            { 0xde34de57572544fcu, 0x18922f31411455a9u }, { 0x55c215ed2cee963bu, 0x1eb6bafd91596b14u },
+            { 0xb5994db43c151de5u, 0x133234de7ad7e2ecu }, { 0xe2ffa1214b1a655eu, 0x17fec216198ddba7u },
+            { 0xdbbf89699de0feb6u, 0x1dfe729b9ff15291u }, { 0x2957b5e202ac9f31u, 0x12bf07a143f6d39bu },
+            { 0xf3ada35a8357c6feu, 0x176ec98994f48881u }, { 0x70990c31242db8bdu, 0x1d4a7bebfa31aaa2u },
+            { 0x865fa79eb69c9376u, 0x124e8d737c5f0aa5u }, { 0xe7f791866443b854u, 0x16e230d05b76cd4eu },
+            { 0xa1f575e7fd54a669u, 0x1c9abd04725480a2u }, { 0xa53969b0fe54e801u, 0x11e0b622c774d065u },
+            { 0x0e87c41d3dea2202u, 0x1658e3ab7952047fu }, { 0xd229b5248d64aa82u, 0x1bef1c9657a6859eu },
+            { 0x435a1136d85eea91u, 0x117571ddf6c81383u }, { 0x143095848e76a536u, 0x15d2ce55747a1864u },
+            { 0x193cbae5b2144e83u, 0x1b4781ead1989e7du }, { 0x2fc5f4cf8f4cb112u, 0x110cb132c2ff630eu },
+            { 0xbbb77203731fdd56u, 0x154fdd7f73bf3bd1u }, { 0x2aa54e844fe7d4acu, 0x1aa3d4df50af0ac6u },
+            { 0xdaa75112b1f0e4ebu, 0x10a6650b926d66bbu }, { 0xd15125575e6d1e26u, 0x14cffe4e7708c06au },
+            { 0x85a56ead360865b0u, 0x1a03fde214caf085u }, { 0x7387652c41c53f8eu, 0x10427ead4cfed653u },
+            { 0x50693e7752368f71u, 0x14531e58a03e8be8u }, { 0x64838e1526c4334eu, 0x1967e5eec84e2ee2u },
+            { 0xfda4719a70754022u, 0x1fc1df6a7a61ba9au }, { 0xde86c70086494815u, 0x13d92ba28c7d14a0u },
+            { 0x162878c0a7db9a1au, 0x18cf768b2f9c59c9u }, { 0x5bb296f0d1d280a1u, 0x1f03542dfb83703bu },
+            { 0x194f9e5683239064u, 0x1362149cbd322625u }, { 0x5fa385ec23ec747eu, 0x183a99c3ec7eafaeu },
+            { 0xf78c67672ce7919du, 0x1e494034e79e5b99u }, { 0x3ab7c0a07c10bb02u, 0x12edc82110c2f940u },
+            { 0x4965b0c89b14e9c3u, 0x17a93a2954f3b790u }, { 0x5bbf1cfac1da2433u, 0x1d9388b3aa30a574u },
+            { 0xb957721cb92856a0u, 0x127c35704a5e6768u }, { 0xe7ad4ea3e7726c48u, 0x171b42cc5cf60142u },
+            { 0xa198a24ce14f075au, 0x1ce2137f74338193u }, { 0x44ff65700cd16498u, 0x120d4c2fa8a030fcu },
+            { 0x563f3ecc1005bdbeu, 0x16909f3b92c83d3bu }, { 0x2bcf0e7f14072d2eu, 0x1c34c70a777a4c8au },
+            { 0x5b61690f6c847c3du, 0x11a0fc668aac6fd6u }, { 0xf239c35347a59b4cu, 0x16093b802d578bcbu },
+            { 0xeec83428198f021fu, 0x1b8b8a6038ad6ebeu }, { 0x553d20990ff96153u, 0x1137367c236c6537u },
+            { 0x2a8c68bf53f7b9a8u, 0x1585041b2c477e85u }, { 0x752f82ef28f5a812u, 0x1ae64521f7595e26u },
+            { 0x093db1d57999890bu, 0x10cfeb353a97dad8u }, { 0x0b8d1e4ad7ffeb4eu, 0x1503e602893dd18eu },
+            { 0x8e7065dd8dffe622u, 0x1a44df832b8d45f1u }, { 0xf9063faa78bfefd5u, 0x106b0bb1fb384bb6u },
+            { 0xb747cf9516efebcau, 0x1485ce9e7a065ea4u }, { 0xe519c37a5cabe6bdu, 0x19a742461887f64du },
+            { 0xaf301a2c79eb7036u, 0x1008896bcf54f9f0u }, { 0xdafc20b798664c43u, 0x140aabc6c32a386cu },
+            { 0x11bb28e57e7fdf54u, 0x190d56b873f4c688u }, { 0x1629f31ede1fd72au, 0x1f50ac6690f1f82au },
+            { 0x4dda37f34ad3e67au, 0x13926bc01a973b1au }, { 0xe150c5f01d88e019u, 0x187706b0213d09e0u },
+            { 0x19a4f76c24eb181fu, 0x1e94c85c298c4c59u }, { 0xb0071aa39712ef13u, 0x131cfd3999f7afb7u },
+            { 0x9c08e14c7cd7aad8u, 0x17e43c8800759ba5u }, { 0x030b199f9c0d958eu, 0x1ddd4baa0093028fu },
+            { 0x61e6f003c1887d79u, 0x12aa4f4a405be199u }, { 0xba60ac04b1ea9cd7u, 0x1754e31cd072d9ffu },
+            { 0xa8f8d705de65440du, 0x1d2a1be4048f907fu }, { 0xc99b8663aaff4a88u, 0x123a516e82d9ba4fu },
+            { 0xbc0267fc95bf1d2au, 0x16c8e5ca239028e3u }, { 0xab0301fbbb2ee474u, 0x1c7b1f3cac74331cu },
+            { 0xeae1e13d54fd4ec9u, 0x11ccf385ebc89ff1u }, { 0x659a598caa3ca27bu, 0x1640306766bac7eeu },
+            { 0xff00efefd4cbcb1au, 0x1bd03c81406979e9u }, { 0x3f6095f5e4ff5ef0u, 0x116225d0c841ec32u },
+            { 0xcf38bb735e3f36acu, 0x15baaf44fa52673eu }, { 0x8306ea5035cf0457u, 0x1b295b1638e7010eu },
+            { 0x11e4527221a162b6u, 0x10f9d8ede39060a9u }, { 0x565d670eaa09bb64u, 0x15384f295c7478d3u },
+            { 0x2bf4c0d2548c2a3du, 0x1a8662f3b3919708u }, { 0x1b78f88374d79a66u, 0x1093fdd8503afe65u },
+            { 0x625736a4520d8100u, 0x14b8fd4e6449bdfeu }, { 0xfaed044d6690e140u, 0x19e73ca1fd5c2d7du },
+            { 0xbcd422b0601a8cc8u, 0x103085e53e599c6eu }, { 0x6c092b5c78212ffau, 0x143ca75e8df0038au },
+            { 0x070b763396297bf8u, 0x194bd136316c046du }, { 0x48ce53c07bb3daf6u, 0x1f9ec583bdc70588u },
+            { 0x2d80f4584d5068dau, 0x13c33b72569c6375u }, { 0x78e1316e60a48310u, 0x18b40a4eec437c52u }
+        };
+
+        template<typename Dummy = void>
+        struct DoublePow5InvSplit
+        {
+            static const uint64_t table[342][2];
+        };
+
+        template<typename Dummy>
+        const uint64_t DoublePow5InvSplit<Dummy>::table[342][2] = {
+            { 0x0000000000000001u, 0x2000000000000000u }, { 0x999999999999999au, 0x1999999999999999u },
+            { 0x47ae147ae147ae15u, 0x147ae147ae147ae1u }, { 0x6c8b4395810624deu, 0x10624dd2f1a9fbe7u },
+            { 0x7a786c226809d496u, 0x1a36e2eb1c432ca5u }, { 0x61f9f01b866e43abu, 0x14f8b588e368f084u },
+            { 0xb4c7f34938583622u, 0x10c6f7a0b5ed8d36u }, { 0x87a6520ec08d236au, 0x1ad7f29abcaf4857u },
+            { 0x9fb841a566d74f88u, 0x15798ee2308c39dfu }, { 0xe62d01511f12a607u, 0x112e0be826d694b2u },
+            { 0xd6ae6881cb5109a4u, 0x1b7cdfd9d7bdbab7u }, { 0xdef1ed34a2a73aeau, 0x15fd7fe17964955fu },
+            { 0x7f27f0f6e885c8bbu, 0x119799812dea1119u }, { 0x650cb4be40d60df8u, 0x1c25c268497681c2u },
+            { 0xea70909833de7193u, 0x16849b86a12b9b01u }, { 0x21f3a6e0297ec143u, 0x1203af9ee756159bu },
+            { 0x6985d7cd0f313537u, 0x1cd2b297d889bc2bu }, { 0x2137dfd73f5a90f9u, 0x170ef54646d49689u },
+            { 0xe75fe645cc4873fau, 0x12725dd1d243aba0u }, { 0xa5663d3c7a0d865du, 0x1d83c94fb6d2ac34u },
+            { 0x511e976394d79eb1u, 0x179ca10c9242235du }, { 0xda7edf82dd794bc1u, 0x12e3b40a0e9b4f7du },
+            { 0x2a6498d1625bac68u, 0x1e392010175ee596u }, { 0xeeb6e0a781e2f053u, 0x182db34012b25144u },
+            { 0x58924d52ce4f26a9u, 0x1357c299a88ea76au }, { 0x27507bb7b07ea441u, 0x1ef2d0f5da7dd8aau },
+            { 0x52a6c95fc0655034u, 0x18c240c4aecb13bbu }, { 0x0eebd44c99eaa690u, 0x13ce9a36f23c0fc9u },
+            { 0xb17953adc3110a80u, 0x1fb0f6be50601941u }, { 0xc12ddc8b02740867u, 0x195a5efea6b34767u },
+            { 0x3424b06f3529a052u, 0x14484bfeebc29f86u }, { 0x901d59f290ee19dbu, 0x1039d66589687f9eu },
+            { 0x4cfbc31db4b0295fu, 0x19f623d5a8a73297u }, { 0x3d9635b15d59bab2u, 0x14c4e977ba1f5bacu },
+            { 0x97ab5e277de16228u, 0x109d8792fb4c4956u }, { 0xf2abc9d8c9689d0du, 0x1a95a5b7f87a0ef0u },
+            { 0x5bbca17a3aba173eu, 0x154484932d2e725au }, { 0xafca1ac82efb45cbu, 0x11039d428a8b8eaeu },
+            { 0xb2dcf7a6b1920945u, 0x1b38fb9daa78e44au }, { 0xf57d92ebc141a104u, 0x15c72fb1552d836eu },
+            { 0xc46475896767b403u, 0x116c262777579c58u }, { 0x6d6d88dbd8a5ecd2u, 0x1be03d0bf225c6f4u },
+            { 0x8abe071646eb23dbu, 0x164cfda3281e38c3u }, { 0x6efe6c11d255b649u, 0x11d7314f534b609cu },
+            { 0xb197134fb6ef8a0eu, 0x1c8b821885456760u }, { 0x27ac0f72f8bfa1a5u, 0x16d601ad376ab91au },
+            { 0xb95672c260994e1eu, 0x1244ce242c5560e1u }, { 0xf5571e03cdc21695u, 0x1d3ae36d13bbce35u },
+            { 0x2aac18030b01ababu, 0x17624f8a762fd82bu }, { 0xbbbce0026f348956u, 0x12b50c6ec4f31355u },
+            { 0x92c7ccd0b1eda889u, 0x1dee7a4ad4b81eefu }, { 0xdbd30a408e57ba07u, 0x17f1fb6f10934bf2u },
+            { 0x7ca8d50071dfc806u, 0x1327fc58da0f6ff5u }, { 0xfaa7bb33e9660cd6u, 0x1ea6608e29b24cbbu },
+            { 0x9552fc298784d711u, 0x18851a0b548ea3c9u }, { 0xaaa8c9bad2d0ac0eu, 0x139dae6f76d88307u },
+            { 0xdddadc5e1e1aace3u, 0x1f62b0b257c0d1a5u }, { 0x7e48b04b4b488a4fu, 0x191bc08eac9a4151u },
+            { 0xcb6d59d5d5d3a1d9u, 0x141633a556e1cddau }, { 0x3c577b1177dc817bu, 0x1011c2eaabe7d7e2u },
+            { 0xc6f25e825960cf2au, 0x19b604aaaca62636u }, { 0x6bf518684780a5bbu, 0x14919d5556eb51c5u },
+            { 0x232a79ed06008496u, 0x10747ddddf22a7d1u }, { 0xd1dd8fe1a3340756u, 0x1a53fc9631d10c81u },
+            { 0xa7e4731ae8f66c45u, 0x150ffd44f4a73d34u }, { 0x531d28e253f8569eu, 0x10d9976a5d52975du },
+            { 0xeb61db03b98d5762u, 0x1af5bf109550f22eu }, { 0xbc4e48cfc7a445e8u, 0x159165a6ddda5b58u },
+            { 0x6371d3d96c836b20u, 0x11411e1f17e1e2adu }, { 0x9f1c8628ad9f11cdu, 0x1b9b6364f3030448u },
+            { 0xe5b06b53be18db0bu, 0x1615e91d8f359d06u }, { 0xeaf3890fcb4715a2u, 0x11ab20e472914a6bu },
+            { 0x44b8db4c7871bc37u, 0x1c45016d841baa46u }, { 0x03c715d6c6c1635fu, 0x169d9abe03495505u },
+            { 0x3638de456bcde919u, 0x1217aefe69077737u }, { 0x56c163a2461641c1u, 0x1cf2b1970e725858u },
+            { 0xdf011c81d1ab67ceu, 0x17288e1271f51379u }, { 0x7f3416ce4155eca5u, 0x1286d80ec190dc61u },
+            { 0x6520247d3556476eu, 0x1da48ce468e7c702u }, { 0xea801d30f7783925u, 0x17b6d71d20b96c01u },
+            { 0xbb99b0f3f92cfa84u, 0x12f8ac174d612334u }, { 0x5f5c4e532847f739u, 0x1e5aacf215683854u },
+            { 0x7f7d0b75b9d32c2eu, 0x18488a5b44536043u }, { 0x9930d5f7c7dc2358u, 0x136d3b7c36a919cfu },
+            { 0x8eb4898c72f9d226u, 0x1f152bf9f10e8fb2u }, { 0x722a07a38f2e41b8u, 0x18ddbcc7f40ba628u },
+            { 0xc1bb394fa5be9afau, 0x13e497065cd61e86u }, { 0x9c5ec2190930f7f6u, 0x1fd424d6faf030d7u },
+            { 0x49e56814075a5ff8u, 0x197683df2f268d79u }, { 0x6e51201005e1e660u, 0x145ecfe5bf520ac7u },
+            { 0xf1da800cd181851au, 0x104bd984990e6f05u }, { 0x4fc400148268d4f5u, 0x1a12f5a0f4e3e4d6u },
+            { 0xd96999aa01ed772bu, 0x14dbf7b3f71cb711u }, { 0xadee1488018ac5bcu, 0x10aff95cc5b09274u },
+            { 0x497ceda668de092cu, 0x1ab328946f80ea54u }, { 0x3aca57b853e4d424u, 0x155c2076bf9a5510u },
+            { 0x623b7960431d7683u, 0x1116805effaeaa73u }, { 0x9d2bf566d1c8bd9eu, 0x1b5733cb32b110b8u },
+            { 0x7dbcc452416d647fu, 0x15df5ca28ef40d60u }, { 0xcafd69db678ab6ccu, 0x117f7d4ed8c33de6u },
+            { 0xab2f0fc572778adfu, 0x1bff2ee48e052fd7u }, { 0x88f273045b92d580u, 0x1665bf1d3e6a8cacu },
+            { 0xd3f528d049424466u, 0x11eaff4a98553d56u }, { 0xb988414d4203a0a3u, 0x1cab3210f3bb9557u },
+            { 0x6139cdd76802e6e9u, 0x16ef5b40c2fc7779u }, { 0xe761717920025254u, 0x125915cd68c9f92du },
+            { 0xa568b58e999d5086u, 0x1d5b561574765b7cu }, { 0x5120913ee14aa6d2u, 0x177c44ddf6c515fdu },
+            { 0xa74d40ff1aa21f0eu, 0x12c9d0b1923744cau }, { 0x0baece64f769cb4au, 0x1e0fb44f50586e11u },
+            { 0x3c8bd850c5ee3c3bu, 0x180c903f7379f1a7u }, { 0xca0979da37f1c9c9u, 0x133d4032c2c7f485u },
+            { 0xa9a8c2f6bfe942dbu, 0x1ec866b79e0cba6fu }, { 0x2153cf2bccba9be3u, 0x18a0522c7e709526u },
+            { 0x1aa9728970954982u, 0x13b374f06526ddb8u }, { 0xf775840f1a88759du, 0x1f8587e7083e2f8cu },
+            { 0x5f9136727ba05e17u, 0x19379fec0698260au }, { 0x1940f85b9619e4dfu, 0x142c7ff0054684d5u },
+            { 0xe100c6afab47ea4cu, 0x1023998cd1053710u }, { 0xce67a44c453fdd47u, 0x19d28f47b4d524e7u },
+            { 0xd852e9d69dccb106u, 0x14a8729fc3ddb71fu }, { 0x79dbee454b0a2738u, 0x1086c219697e2c19u },
+            { 0x295fe3a211a9d859u, 0x1a71368f0f30468fu }, { 0xbab31c81a7bb137au, 0x15275ed8d8f36ba5u },
+            { 0x6228e39aec95a92fu, 0x10ec4be0ad8f8951u }, { 0x9d0e38f7e0ef7517u, 0x1b13ac9aaf4c0ee8u },
+            { 0xb0d82d931a592a79u, 0x15a956e225d67253u }, { 0x8d79be0f4847552eu, 0x11544581b7dec1dcu },
+            { 0x158f967eda0bbb7cu, 0x1bba08cf8c979c94u }, { 0x77a611ff14d62f97u, 0x162e6d72d6dfb076u },
+            { 0xf951a7ff43de8c79u, 0x11bebdf578b2f391u }, { 0xc21c3ffed2fdad8eu, 0x1c6463225ab7ec1cu },
+            { 0x01b0333242648ad8u, 0x16b6b5b5155ff017u }, { 0x0159c28e9b83a246u, 0x122bc490dde659acu },
+            { 0xcef604175f3903a3u, 0x1d12d41afca3c2acu }, { 0x725e69ac4c2d9c83u, 0x17424348ca1c9bbdu },
+            { 0xf5185489d68ae39cu, 0x129b69070816e2fdu }, { 0xee8d540fbdab05c6u, 0x1dc574d80cf16b2fu },
+            { 0xbed77672fe226b05u, 0x17d12a4670c1228cu }, { 0xff12c528cb4ebc04u, 0x130dbb6b8d674ed6u },
+            { 0xcb513b74787df9a0u, 0x1e7c5f127bd87e24u }, { 0x090dc929f9fe614du, 0x18637f41fcad31b7u },
+            { 0xa0d7d42194cb810au, 0x1382cc34ca2427c5u }, { 0x67bfb9cf5478ce77u, 0x1f37ad21436d0c6fu },
+            { 0x1fcc94a5dd2d71f9u, 0x18f9574dcf8a7059u }, { 0x7fd6dd517dbdf4c7u, 0x13faac3e3fa1f37au },
+            { 0xffbe2ee8c92fee0bu, 0x1ff779fd329cb8c3u }, { 0x6631bf20a0f324d6u, 0x1992c7fdc216fa36u },
+            { 0xb827cc1a1a5c1d78u, 0x14756ccb01abfb5eu }, { 0x935309ae7b7ce460u, 0x105df0a267bcc918u },
+            { 0x1eeb42b0c594a099u, 0x1a2fe76a3f9474f4u }, { 0xe58902270476e6e1u, 0x14f31f8832dd2a5cu },
+            { 0xb7a0ce859d2bebe7u, 0x10c27fa028b0eeb0u }, { 0x59014a6f61dfdfd8u, 0x1ad0cc33744e4ab4u },
+            { 0xe0cdd525e7e64cadu, 0x1573d68f903ea229u }, { 0x4d7177518651d6f1u, 0x11297872d9cbb4eeu },
+            { 0x7be8bee8d6e957e8u, 0x1b758d848fac54b0u }, { 0xfcba3253df211320u, 0x15f7a46a0c89dd59u },
+            { 0x63c8284318e74280u, 0x1192e9ee706e4aaeu }, { 0x060d0d3827d86a66u, 0x1c1e43171a4a1117u },
+            { 0x6b3da42cecad21ebu, 0x167e9c127b6e7412u }, { 0x88fe1cf0bd574e56u, 0x11fee341fc585cdbu },
+            { 0x419694b462254a23u, 0x1ccb0536608d615fu }, { 0x67abaa29e81dd4e9u, 0x1708d0f84d3de77fu },
+            { 0xb95621bb2017dd87u, 0x126d73f9d764b932u }, { 0xc223692b668c95a5u, 0x1d7becc2f23ac1eau },
+            { 0xce82ba891ed6de1du, 0x179657025b6234bbu }, { 0xa53562074bdf1818u, 0x12deac01e2b4f6fcu },
+            { 0x3b889cd87964f359u, 0x1e3113363787f194u }, { 0xfc6d4a46c783f5e1u, 0x18274291c6065adcu },
+            { 0x30576e9f06032b1au, 0x13529ba7d19eaf17u }, { 0x1a257dcb3cd1de90u, 0x1eea92a61c311825u },
+            { 0x481dfe3c30a7e540u, 0x18bba884e35a79b7u }, { 0xd34b31c9c0865100u, 0x13c9539d82aec7c5u },
+            { 0x5211e942cda3b4cdu, 0x1fa885c8d117a609u }, { 0x74db21023e1c90a4u, 0x19539e3a40dfb807u },
+            { 0xf715b401cb4a0d50u, 0x1442e4fb67196005u }, { 0xf8de299b09080aa7u, 0x103583fc527ab337u },
+            { 0x8e304291a80cddd7u, 0x19ef3993b72ab859u }, { 0x3e8d020e200a4b13u, 0x14bf6142f8eef9e1u },
+            { 0x653d9b3e80083c0fu, 0x10991a9bfa58c7e7u }, { 0x6ec8f864000d2ce4u, 0x1a8e90f9908e0ca5u },
+            { 0x8bd3f9e999a423eau, 0x153eda614071a3b7u }, { 0x3ca994bae1501cbbu, 0x10ff151a99f482f9u },
+            { 0xc775bac49bb3612bu, 0x1b31bb5dc320d18eu }, { 0xd2c4956a16291a89u, 0x15c162b168e70e0bu },
+            { 0xdbd0778811ba7ba1u, 0x11678227871f3e6fu }, { 0x2c80bf401c5d929bu, 0x1bd8d03f3e9863e6u },
+            { 0xbd33cc3349e47549u, 0x16470cff6546b651u }, { 0xca8fd68f6e505dd4u, 0x11d270cc51055ea7u },
+            { 0x4419574be3b3c953u, 0x1c83e7ad4e6efdd9u }, { 0x0347790982f63aa9u, 0x16cfec8aa52597e1u },
+            { 0xcf6c60d468c4fbbau, 0x123ff06eea847980u }, { 0xe57a34870e07f92au, 0x1d331a4b10d3f59au },
+            { 0x512e906c0b399422u, 0x175c1508da432ae2u }, { 0xda8ba6bcd5c7a9b5u, 0x12b010d3e1cf5581u },
+            { 0x90df712e22d90f87u, 0x1de6815302e5559cu }, { 0xda4c5a8b4f140c6cu, 0x17eb9aa8cf1dde16u },
+            { 0xaea37ba2a5a9a38au, 0x1322e220a5b17e78u }, { 0x7dd25f6aa2a905a9u, 0x1e9e369aa2b59727u },
+            { 0x97db7f888220d154u, 0x187e92154ef7ac1fu }, { 0x797c6606ce80a777u, 0x139874ddd8c6234cu },
+            { 0x8f2d700ae4010bf1u, 0x1f5a549627a36badu }, { 0x0c2459a25000d65au, 0x191510781fb5efbeu },
+            { 0x701d1481d99a4515u, 0x1410d9f9b2f7f2feu }, { 0xc017439b147b6a77u, 0x100d7b2e28c65bfeu },
+            { 0xccf205c4ed9243f2u, 0x19af2b7d0e0a2ccau }, { 0x0a5b37d0be0e9cc2u, 0x148c22ca71a1bd6fu },
+            { 0x0848f973cb3ee3ceu, 0x10701bd527b4978cu }, { 0xda0e5bec78649fb0u, 0x1a4cf9550c5425acu },
+            { 0x7b3eaff060507fc0u, 0x150a6110d6a9b7bdu }, { 0x95cbbff380406633u, 0x10d51a73deee2c97u },
+            { 0xefac665266cd7052u, 0x1aee90b964b04758u }, { 0x2623850eb8a459dbu, 0x158ba6fab6f36c47u },
+            { 0x1e82d0d893b6ae49u, 0x113c85955f29236cu }, { 0xfd9e1af41f8ab075u, 0x1b9408eefea838acu },
+            { 0x97b1af29b2d559f7u, 0x16100725988693bdu }, { 0xac8e25baf5777b2cu, 0x11a66c1e139edc97u },
+            { 0x7a7d092b2258c513u, 0x1c3d79c9b8fe2dbfu }, { 0x61fda0ef4ead6a76u, 0x169794a160cb57ccu },
+            { 0xe7fe1a590bbdeec5u, 0x1212dd4de7091309u }, { 0xa6635d5b45fcb13au, 0x1ceafbafd80e84dcu },
+            { 0x851c4aaf6b308dc8u, 0x172262f3133ed0b0u }, { 0xd0e36ef2bc26d7d4u, 0x1281e8c275cbda26u },
+            { 0xb49f17eac6a48c86u, 0x1d9ca79d894629d7u }, { 0x2a18dfef0550706bu, 0x17b08617a104ee46u },
+            { 0x54e0b3259dd9f389u, 0x12f39e794d9d8b6bu }, { 0x87cdeb6f62f65274u, 0x1e5297287c2f4578u },
+            { 0xd30b22bf825ea85du, 0x18421286c9bf6ac6u }, { 0x0f3c1bcc684bb9e4u, 0x13680ed23aff889fu },
+            { 0x18602c7a4079296du, 0x1f0ce4839198da98u }, { 0x46b356c833942124u, 0x18d71d360e13e213u },
+            { 0x388f78a029434db6u, 0x13df4a91a4dcb4dcu }, { 0x5a7f2766a86baf8au, 0x1fcbaa82a1612160u },
+            { 0x153285ebb9efbfa2u, 0x196fbb9bb44db44du }, { 0xaa8ed189618c994eu, 0x145962e2f6a4903du },
+            { 0xeed8a7a11ad6e10cu, 0x1047824f2bb6d9cau }, { 0x7e27729b5e249b45u, 0x1a0c03b1df8af611u },
+            { 0xfe85f549181d4904u, 0x14d6695b193bf80du }, { 0xcb9e5dd4134aa0d0u, 0x10ab877c142ff9a4u },
+            { 0xdf63c9535211014du, 0x1aac0bf9b9e65c3au }, { 0x191ca10f74da6771u, 0x15566ffafb1eb02fu },
+            { 0xadb080d92a4852c1u, 0x1111f32f2f4bc025u }, { 0x15e7348eaa0d5134u, 0x1b4feb7eb212cd09u },
+            { 0xab1f5d3eee710dc4u, 0x15d98932280f0a6du }, { 0xbc1917658b8da49du, 0x117ad428200c0857u },
+            { 0x2cf4f23c127c3a94u, 0x1bf7b9d9cce00d59u }, { 0xf0c3f4fcdb969543u, 0x165fc7e170b33de0u },
+            { 0x5a365d9716121103u, 0x11e6398126f5cb1au }, { 0x9056fc24f01ce804u, 0x1ca38f350b22de90u },
+            { 0xd9df301d8ce3ecd0u, 0x16e93f5da2824ba6u }, { 0xe17f59b13d8323dau, 0x125432b14ecea2ebu },
+            { 0x68cbc2b52f38395cu, 0x1d53844ee47dd179u }, { 0x53d6355dbf602de3u, 0x177603725064a794u },
+            { 0xa9782ab165e68b1cu, 0x12c4cf8ea6b6ec76u }, { 0x0f26aab56fd744fau, 0x1e07b27dd78b13f1u },
+            { 0x3f52222abfdf6a62u, 0x18062864ac6f4327u }, { 0x65db4e88997f884eu, 0x1338205089f29c1fu },
+            { 0x6fc54a7428cc0d4au, 0x1ec033b40fea9365u }, { 0x596aa1f68709a43bu, 0x1899c2f673220f84u },
+            { 0xadeee7f86c07b696u, 0x13ae3591f5b4d936u }, { 0x497e3ff3e00c5756u, 0x1f7d228322baf524u },
+            { 0xd464fff64cd6ac45u, 0x1930e868e89590e9u }, { 0x4383fff83d7889d1u, 0x14272053ed4473eeu },
+            { 0xcf9cccc69793a174u, 0x101f4d0ff1038ff1u }, { 0x7f6147a425b90252u, 0x19cbae7fe805b31cu },
+            { 0xcc4dd2e9b7c7350fu, 0x14a2f1ffecd15c16u }, { 0x3d0b0f215fd290d9u, 0x10825b3323dab012u },
+            { 0x61ab4b689950e7c1u, 0x1a6a2b85062ab350u }, { 0x4e22a2ba1440b967u, 0x1521bc6a6b555c40u },
+            { 0x0b4ee894dd009453u, 0x10e7c9eebc4449cdu }, { 0x1217da87c800ed51u, 0x1b0c764ac6d3a948u },
+            { 0xdb46486ca000bddau, 0x15a391d56bdc876cu }, { 0x490506bd4ccd64afu, 0x114fa7ddefe39f8au },
+            { 0xa8080ac87ae23ab1u, 0x1bb2a62fe638ff43u }, { 0x5339a239fbe82ef4u, 0x162884f31e93ff69u },
+            { 0x75c7b4fb2fecf25du, 0x11ba03f5b20fff87u }, { 0x22d92191e647ea2eu, 0x1c5cd322b67fff3fu },
+            { 0xb57a8141850654f2u, 0x16b0a8e891ffff65u }, { 0xc4620101373843f5u, 0x1226ed86db3332b7u },
+            { 0x3a366801f1f39feeu, 0x1d0b15a491eb8459u }, { 0xfb5eb99b27f6198bu, 0x173c115074bc69e0u },
+            { 0x2f7efae2865e7ad6u, 0x129674405d6387e7u }, { 0xe597f7d0d6fd9156u, 0x1dbd86cd6238d971u },
+            { 0x8479930d78cadaabu, 0x17cad23de82d7ac1u }, { 0xd06142712d6f1556u, 0x1308a831868ac89au },
+            { 0x4d686a4eaf182222u, 0x1e74404f3daada91u }, { 0xa453883ef279b4e8u, 0x185d003f6488aedau },
+            { 0xe9dc6cff28615d87u, 0x137d99cc506d58aeu }, { 0xa960ae650d6895a4u, 0x1f2f5c7a1a488de4u },
+            { 0xbab3beb73ded4483u, 0x18f2b061aea07183u }, { 0x2ef6322c318a9d36u, 0x13f559e7bee6c136u },
+            { 0xe4bd1d13827761f0u, 0x1feef63f97d79b89u }, { 0x83ca7da9352c4e5au, 0x198bf832dfdfafa1u },
+            { 0x9ca1fe20f756a515u, 0x146ff9c24cb2f2e7u }, { 0x4a1b31b3f9121daau, 0x1059949b708f28b9u },
+            { 0x435eb5ecc1b695ddu, 0x1a28edc580e50df5u }, { 0x35e55e57015ede4au, 0x14ed8b04671da4c4u },
+            { 0xc4b77eac0118b1d5u, 0x10be08d0527e1d69u }, { 0xa12597799b5ab622u, 0x1ac9a7b3b7302f0fu },
+            { 0x4db7ac6149155e81u, 0x156e1fc2f8f358d9u }, { 0xd7c6238107444b9bu, 0x1124e63593f5e0adu },
+            { 0x593d059b3ed3ac2bu, 0x1b6e3d2286563449u }, { 0xe0fd9e15cbdc89bcu, 0x15f1ca820511c36du },
+            { 0xb3fe18116fe3a163u, 0x118e3b9b37416924u }, { 0x866359b57fd29bd1u, 0x1c16c5c525357507u },
+            { 0xd1e91491330ee30eu, 0x16789e3750f790d2u }, { 0x74ba76da8f3f1c0bu, 0x11fa182c40c60d75u },
+            { 0xedf72490e531c678u, 0x1cc359e067a348bbu }, { 0x8b2c1d40b75b052du, 0x1702ae4d1fb5d3c9u },
+            { 0x6f567dcd5f7c0424u, 0x12688b70e62b0fd4u }, { 0x7ef0c94898c66d06u, 0x1d74124e3d11b2edu },
+            { 0x98c0a106e09ebd9fu, 0x17900ea4fda7c257u }, { 0x470080d24d4bcae6u, 0x12d9a550caec9b79u },
+            { 0xd800ce1d487944a2u, 0x1e29088144adc58eu }, { 0x1333d8176d2dd082u, 0x1820d39a9d57d13fu },
+            { 0xa8f646792424a6ceu, 0x134d76154aaca765u }, { 0x74bd3d8ea03aa47du, 0x1ee25688777aa56fu },
+            { 0x5d64313ee6955064u, 0x18b51206c5fbb78cu }, { 0x4ab68dcbebaaa6b7u, 0x13c40e6bd1962c70u },
+            { 0x1124161312aaa457u, 0x1fa01712e8f0471au }, { 0xda8344dc0eeee9dfu, 0x194cdf4253f36c14u },
+            { 0xe2029d7cd8bf2180u, 0x143d7f6843292343u }, { 0x4e687dfd7a328133u, 0x103132b9cf541c36u },
+            { 0x4a40c9959050ceb8u, 0x19e851294bb9c6bdu }, { 0x0833d477a6a70bc6u, 0x14b9da876fc7d231u },
+            { 0xa02976c61eec096bu, 0x1094aed2bfd30e8du }, { 0x004257a364acdbdfu, 0x1a877e1dffb81749u },
+            { 0xcd01dfb5ea23e319u, 0x153931b1996012a0u }, { 0x70ce4c91881cb5aeu, 0x10fa8e27ade6754du },
+            { 0x1ae3adb5a69455e2u, 0x1b2a7d0c4970bbafu }, { 0x7be957c4854377e8u, 0x15bb973d078d62f2u },
+            { 0xc987796a0435f987u, 0x1162df64060ab58eu }, { 0x75a58f1006bcc271u, 0x1bd1656cd67788e4u },
+            { 0xf7b7a5a66bca3527u, 0x16411df0ab92d3e9u }, { 0x5fc61e1ebca1c41fu, 0x11cdb18d560f0feeu },
+            { 0xffa363646102d365u, 0x1c7c4f4889b1b316u }, { 0x32e91c504d9bdc51u, 0x16c9d906d48e28dfu },
+            { 0x8f20e37371497d0eu, 0x123b140576d820b2u }, { 0x7e9b0585820f2e7cu, 0x1d2b533bf159cdeau },
+            { 0xcbaf379e01a5becau, 0x1755dc2ff447d7eeu }, { 0x0958f94b348498a1u, 0x12ab168cc36cacbfu }
+        };
+
+        /// Multiplies two 64-bit integers, returns the low half of the 128-bit product and stores its high half in `high`.
+        inline uint64_t multiply128(uint64_t a, uint64_t b, uint64_t& high) noexcept
+        {
+#ifdef STRINGBUILDER_SUPPORTS_INT128
+            const UInt128 product = static_cast<UInt128>(a) * b;
+            high = static_cast<uint64_t>(product >> 64);
+            return static_cast<uint64_t>(product);
+#elif defined(_MSC_VER) && defined(_M_X64)
+            return _umul128(a, b, &high);
+#else
+            const uint64_t aLow = static_cast<uint32_t>(a), aHigh = a >> 32;
+            const uint64_t bLow = static_cast<uint32_t>(b), bHigh = b >> 32;
+            const uint64_t lowLow = aLow * bLow, lowHigh = aLow * bHigh, highLow = aHigh * bLow;
+            const uint64_t middle = (lowLow >> 32) + static_cast<uint32_t>(lowHigh) + static_cast<uint32_t>(highLow);
+            high = aHigh * bHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+            return (middle << 32) | static_cast<uint32_t>(lowLow);
+#endif
+        }
+
+        /// Computes (m * mul) >> j, where `mul` is a 128-bit number stored as { low, high } and 64 < j < 128.
+        inline uint64_t multiplyShift128(uint64_t m, const uint64_t* mul, int j) noexcept
+        {
+            uint64_t high0;
+            multiply128(m, mul[0], high0);
+            uint64_t high1;
+            const uint64_t low1 = multiply128(m, mul[1], high1);
+            const uint64_t sum = high0 + low1;
+            high1 += sum < high0 ? 1 : 0;
+            const int shift = j - 64;
+            assert(shift > 0 && shift < 64);
+            return (high1 << (64 - shift)) | (sum >> shift);
+        }
+
+        /// Gets the bit length of 5^e (1 for e = 0), valid for 0 <= e <= 3528.
+        inline int pow5Bits(int e) noexcept { return static_cast<int>((static_cast<uint32_t>(e) * 1217359) >> 19) + 1; }
+
+        /// Gets floor(log10(2^e)), valid for 0 <= e <= 1650.
+        inline int log10Pow2(int e) noexcept { return static_cast<int>((static_cast<uint32_t>(e) * 78913) >> 18); }
+
+        /// Gets floor(log10(5^e)), valid for 0 <= e <= 2620.
+        inline int log10Pow5(int e) noexcept { return static_cast<int>((static_cast<uint32_t>(e) * 732923) >> 20); }
+
+        inline bool isMultipleOfPowerOf5(uint64_t v, int p) noexcept
+        {
+            int count = 0;
+            for (; v % 5 == 0; v /= 5) ++count;
+            return count >= p;
+        }
+
+        inline bool isMultipleOfPowerOf2(uint64_t v, int p) noexcept { return (v & ((uint64_t{1} << p) - 1)) == 0; }
+
+        /// Gets the maximal number of characters of the shortest round-trip representation of FloatT, e.g. "-2.2250738585072014e-308" for double.
+        template<typename FloatT>
+        constexpr size_t maxShortestWidth() noexcept
+        {
+            return 1 + std::numeric_limits<FloatT>::max_digits10 + 1 + 2 + (std::numeric_limits<FloatT>::max_exponent10 >= 100 ? 3 : 2);
+        }
+
+        /// Decimal floating-point number equal to mantissa * 10^exponent.
+        struct DecimalFloat
+        {
+            uint64_t mantissa;
+            int exponent;
+        };
+
+        /// Finds the shortest decimal number which rounds back to the positive, finite and non-zero double of given raw IEEE 754 fields (the Ryu algorithm).
+        /// Among the shortest candidates the one closest to the exact binary value is chosen.
+        inline DecimalFloat shortestDecimal64(uint64_t ieeeMantissa, uint32_t ieeeExponent) noexcept
+        {
+            constexpr int mantissaBits = 52;
+            constexpr int bias = 1023;
+            constexpr int pow5BitCount = 125;
+            constexpr int pow5InvBitCount = 125;
+
+            // Step 1: Decode the value as m2 * 2^e2, with 2 bits of extra room for the bounds of the rounding interval.
+            const int e2 = (ieeeExponent == 0 ? 1 : static_cast<int>(ieeeExponent)) - bias - mantissaBits - 2;
+            const uint64_t m2 = ieeeExponent == 0 ? ieeeMantissa : (uint64_t{1} << mantissaBits) | ieeeMantissa;
+            const bool acceptBounds = (m2 & 1) == 0;
+
+            // Step 2: The interval of values rounding to the double is (mm, mp) * 2^e2, which is closed for even mantissas.
+            const uint64_t mv = 4 * m2;
+            const uint32_t mmShift = ieeeMantissa != 0 || ieeeExponent <= 1 ? 1 : 0;
+
+            // Step 3: Convert the interval to a decimal power base.
+            uint64_t vr, vp, vm;
+            int e10;
+            bool vmIsTrailingZeros = false;
+            bool vrIsTrailingZeros = false;
+            if (e2 >= 0) {
+                const int q = log10Pow2(e2) - (e2 > 3 ? 1 : 0);
+                e10 = q;
+                const int k = pow5InvBitCount + pow5Bits(q) - 1;
+                const int i = -e2 + q + k;
+                const uint64_t* const mul = DoublePow5InvSplit<>::table[q];
+                vr = multiplyShift128(4 * m2, mul, i);
+                vp = multiplyShift128(4 * m2 + 2, mul, i);
+                vm = multiplyShift128(4 * m2 - 1 - mmShift, mul, i);
+                if (q <= 21) {
+                    // Only one of mp, mv and mm can be a multiple of 5, if any.
+                    if (mv % 5 == 0) {
+                        vrIsTrailingZeros = isMultipleOfPowerOf5(mv, q);
+                    }
+                    else if (acceptBounds) {
+                        vmIsTrailingZeros = isMultipleOfPowerOf5(mv - 1 - mmShift, q);
+                    }
+                    else {
+                        vp -= isMultipleOfPowerOf5(mv + 2, q) ? 1 : 0;
+                    }
+                }
+            }
+            else {
+                const int q = log10Pow5(-e2) - (-e2 > 1 ? 1 : 0);
+                e10 = q + e2;
+                const int i = -e2 - q;
+                const int k = pow5Bits(i) - pow5BitCount;
+                const int j = q - k;
+                const uint64_t* const mul = DoublePow5Split<>::table[i];
+                vr = multiplyShift128(4 * m2, mul, j);
+                vp = multiplyShift128(4 * m2 + 2, mul, j);
+                vm = multiplyShift128(4 * m2 - 1 - mmShift, mul, j);
+                if (q <= 1) {
+                    // mv = 4 * m2 always has at least two trailing zero bits.
+                    vrIsTrailingZeros = true;
+                    if (acceptBounds) {
+                        vmIsTrailingZeros = mmShift == 1;
+                    }
+                    else {
+                        --vp;
+                    }
+                }
+                else if (q < 63) {
+                    vrIsTrailingZeros = isMultipleOfPowerOf2(mv, q);
+                }
+            }
+
+            // Step 4: Remove the digits while the interval still contains a shorter number.
+            int removed = 0;
+            uint64_t output;
+            if (STRINGBUILDER_UNLIKELY(vmIsTrailingZeros || vrIsTrailingZeros)) {
+                // The exact decimal value ends with zeros, so the ties are decided on the removed digits themselves (rare).
+                uint32_t lastRemovedDigit = 0;
+                for (; vp / 10 > vm / 10; ++removed) {
+                    vmIsTrailingZeros &= vm % 10 == 0;
+                    vrIsTrailingZeros &= lastRemovedDigit == 0;
+                    lastRemovedDigit = static_cast<uint32_t>(vr % 10);
+                    vr /= 10;
+                    vp /= 10;
+                    vm /= 10;
+                }
+                if (vmIsTrailingZeros) {
+                    for (; vm % 10 == 0; ++removed) {
+                        vrIsTrailingZeros &= lastRemovedDigit == 0;
+                        lastRemovedDigit = static_cast<uint32_t>(vr % 10);
+                        vr /= 10;
+                        vp /= 10;
+                        vm /= 10;
+                    }
+                }
+                if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) {
+                    // Round half to even.
+                    lastRemovedDigit = 4;
+                }
+                output = vr + (((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5) ? 1 : 0);
+            }
+            else {
+                bool roundUp = false;
+                if (vp / 100 > vm / 100) {
+                    // Most of the time at least two digits go away, so remove them at once.
+                    roundUp = vr % 100 >= 50;
+                    vr /= 100;
+                    vp /= 100;
+                    vm /= 100;
+                    removed += 2;
+                }
+                for (; vp / 10 > vm / 10; ++removed) {
+                    roundUp = vr % 10 >= 5;
+                    vr /= 10;
+                    vp /= 10;
+                    vm /= 10;
+                }
+                output = vr + ((vr == vm || roundUp) ? 1 : 0);
+            }
+            return { output, e10 + removed };
+        }
+
+        /// Powers of 5 normalized to 61 significant bits (5^i, i < 47) and their reciprocals scaled by 2^(bitlength(5^i) - 1 + 59) and rounded up (i < 31),
+        /// as used by the single-precision variant of the Ryu algorithm.
+        template<typename Dummy = void>
+        struct FloatPow5Split
+        {
+            static const uint64_t table[47];
+        };
+
+        template<typename Dummy>
+        const uint64_t FloatPow5Split<Dummy>::table[47] = {
+            0x1000000000000000u, 0x1400000000000000u, 0x1900000000000000u, 0x1f40000000000000u,
+            0x1388000000000000u, 0x186a000000000000u, 0x1e84800000000000u, 0x1312d00000000000u,
+            0x17d7840000000000u, 0x1dcd650000000000u, 0x12a05f2000000000u, 0x174876e800000000u,
+            0x1d1a94a200000000u, 0x12309ce540000000u, 0x16bcc41e90000000u, 0x1c6bf52634000000u,
+            0x11c37937e0800000u, 0x16345785d8a00000u, 0x1bc16d674ec80000u, 0x1158e460913d0000u,
+            0x15af1d78b58c4000u, 0x1b1ae4d6e2ef5000u, 0x10f0cf064dd59200u, 0x152d02c7e14af680u,
+            0x1a784379d99db420u, 0x108b2a2c28029094u, 0x14adf4b7320334b9u, 0x19d971e4fe8401e7u,
+            0x1027e72f1f128130u, 0x1431e0fae6d7217cu, 0x193e5939a08ce9dbu, 0x1f8def8808b02452u,
+            0x13b8b5b5056e16b3u, 0x18a6e32246c99c60u, 0x1ed09bead87c0378u, 0x13426172c74d822bu,
+            0x1812f9cf7920e2b6u, 0x1e17b84357691b64u, 0x12ced32a16a1b11eu, 0x178287f49c4a1d66u,
+            0x1d6329f1c35ca4bfu, 0x125dfa371a19e6f7u, 0x16f578c4e0a060b5u, 0x1cb2d6f618c878e3u,
+            0x11efc659cf7d4b8du, 0x166bb7f0435c9e71u, 0x1c06a5ec5433c60du
+        };
+
+        template<typename Dummy = void>
+        struct FloatPow5InvSplit
+        {
+            static const uint64_t table[31];
+        };
+
+        template<typename Dummy>
+        const uint64_t FloatPow5InvSplit<Dummy>::table[31] = {
+            0x0800000000000001u, 0x0666666666666667u, 0x051eb851eb851eb9u, 0x04189374bc6a7efau,
+            0x068db8bac710cb2au, 0x053e2d6238da3c22u, 0x0431bde82d7b634eu, 0x06b5fca6af2bd216u,
+            0x055e63b88c230e78u, 0x044b82fa09b5a52du, 0x06df37f675ef6eaeu, 0x057f5ff85e592558u,
+            0x0465e6604b7a8447u, 0x0709709a125da071u, 0x05a126e1a84ae6c1u, 0x0480ebe7b9d58567u,
+            0x0734aca5f6226f0bu, 0x05c3bd5191b525a3u, 0x049c97747490eae9u, 0x0760f253edb4ab0eu,
+            0x05e72843249088d8u, 0x04b8ed0283a6d3e0u, 0x078e480405d7b966u, 0x060b6cd004ac9452u,
+            0x04d5f0a66a23a9dbu, 0x07bcb43d769f762bu, 0x063090312bb2c4efu, 0x04f3a68dbc8f03f3u,
+            0x07ec3daf94180651u, 0x065697bfa9acd1dau, 0x051212ffbaf0a7e2u
+        };
+
+        /// Computes (m * factor) >> shift, where 32 < shift < 96, in 64-bit arithmetic.
+        inline uint32_t multiplyShift64(uint32_t m, uint64_t factor, int shift) noexcept
+        {
+            assert(shift > 32);
+            const uint64_t low = static_cast<uint64_t>(m) * static_cast<uint32_t>(factor);
+            const uint64_t high = static_cast<uint64_t>(m) * static_cast<uint32_t>(factor >> 32);
+            return static_cast<uint32_t>(((low >> 32) + high) >> (shift - 32));
+        }
+
+        /// Finds the shortest decimal number which rounds back to the positive, finite and non-zero float of given raw IEEE 754 fields (the Ryu algorithm).
+        /// It is the same search as shortestDecimal64(), but in 32-bit integers with 64-bit multiplications and tables.
+        inline DecimalFloat shortestDecimal32(uint32_t ieeeMantissa, uint32_t ieeeExponent) noexcept
+        {
+            constexpr int mantissaBits = 23;
+            constexpr int bias = 127;
+            constexpr int pow5BitCount = 61;
+            constexpr int pow5InvBitCount = 59;
+
+            const int e2 = (ieeeExponent == 0 ? 1 : static_cast<int>(ieeeExponent)) - bias - mantissaBits - 2;
+            const uint32_t m2 = ieeeExponent == 0 ? ieeeMantissa : (uint32_t{1} << mantissaBits) | ieeeMantissa;
+            const bool acceptBounds = (m2 & 1) == 0;
+
+            const uint32_t mv = 4 * m2;
+            const uint32_t mp = 4 * m2 + 2;
+            const uint32_t mmShift = ieeeMantissa != 0 || ieeeExponent <= 1 ? 1 : 0;
+            const uint32_t mm = 4 * m2 - 1 - mmShift;
+
+            uint32_t vr, vp, vm;
+            int e10;
+            bool vmIsTrailingZeros = false;
+            bool vrIsTrailingZeros = false;
+            uint32_t lastRemovedDigit = 0;
+            if (e2 >= 0) {
+                const int q = log10Pow2(e2);
+                e10 = q;
+                const int k = pow5InvBitCount + pow5Bits(q) - 1;
+                const int i = -e2 + q + k;
+                const uint64_t mul = FloatPow5InvSplit<>::table[q];
+                vr = multiplyShift64(mv, mul, i);
+                vp = multiplyShift64(mp, mul, i);
+                vm = multiplyShift64(mm, mul, i);
+                if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+                    // No digit is going to be removed below, but the last one removed by the scaling itself decides the rounding.
+                    const int l = pow5InvBitCount + pow5Bits(q - 1) - 1;
+                    lastRemovedDigit = multiplyShift64(mv, FloatPow5InvSplit<>::table[q - 1], -e2 + q - 1 + l) % 10;
+                }
+                if (q <= 9) {
+                    // Only one of mp, mv and mm can be a multiple of 5, if any.
+                    if (mv % 5 == 0) {
+                        vrIsTrailingZeros = isMultipleOfPowerOf5(mv, q);
+                    }
+                    else if (acceptBounds) {
+                        vmIsTrailingZeros = isMultipleOfPowerOf5(mm, q);
+                    }
+                    else {
+                        vp -= isMultipleOfPowerOf5(mp, q) ? 1 : 0;
+                    }
+                }
+            }
+            else {
+                const int q = log10Pow5(-e2);
+                e10 = q + e2;
+                const int i = -e2 - q;
+                const int k = pow5Bits(i) - pow5BitCount;
+                const int j = q - k;
+                const uint64_t mul = FloatPow5Split<>::table[i];
+                vr = multiplyShift64(mv, mul, j);
+                vp = multiplyShift64(mp, mul, j);
+                vm = multiplyShift64(mm, mul, j);
+                if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+                    const int l = q - 1 - (pow5Bits(i + 1) - pow5BitCount);
+                    lastRemovedDigit = multiplyShift64(mv, FloatPow5Split<>::table[i + 1], l) % 10;
+                }
+                if (q <= 1) {
+                    // mv = 4 * m2 always has at least two trailing zero bits.
+                    vrIsTrailingZeros = true;
+                    if (acceptBounds) {
+                        vmIsTrailingZeros = mmShift == 1;
+                    }
+                    else {
+                        --vp;
+                    }
+                }
+                else if (q < 31) {
+                    vrIsTrailingZeros = isMultipleOfPowerOf2(mv, q - 1);
+                }
+            }
+
+            int removed = 0;
+            uint32_t output;
+            if (STRINGBUILDER_UNLIKELY(vmIsTrailingZeros || vrIsTrailingZeros)) {
+                for (; vp / 10 > vm / 10; ++removed) {
+                    vmIsTrailingZeros &= vm % 10 == 0;
+                    vrIsTrailingZeros &= lastRemovedDigit == 0;
+                    lastRemovedDigit = vr % 10;
+                    vr /= 10;
+                    vp /= 10;
+                    vm /= 10;
+                }
+                if (vmIsTrailingZeros) {
+                    for (; vm % 10 == 0; ++removed) {
+                        vrIsTrailingZeros &= lastRemovedDigit == 0;
+                        lastRemovedDigit = vr % 10;
+                        vr /= 10;
+                        vp /= 10;
+                        vm /= 10;
+                    }
+                }
+                if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) {
+                    // Round half to even.
+                    lastRemovedDigit = 4;
+                }
+                output = vr + (((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5) ? 1 : 0);
+            }
+            else {
+                for (; vp / 10 > vm / 10; ++removed) {
+                    lastRemovedDigit = vr % 10;
+                    vr /= 10;
+                    vp /= 10;
+                    vm /= 10;
+                }
+                output = vr + ((vr == vm || lastRemovedDigit >= 5) ? 1 : 0);
+            }
+            return { output, e10 + removed };
+        }
+
+        /// Gets the number of characters of an unsigned decimal floating-point number of `digitCount` digits in the fixed notation.
+        inline size_t fixedNotationSize(unsigned digitCount, int exponent) noexcept
+        {
+            return exponent >= 0 ? digitCount + static_cast<size_t>(exponent)   // "1500"
+                : static_cast<int>(digitCount) > -exponent ? digitCount + 1     // "1.5"
+                : static_cast<size_t>(2 - exponent);                            // "0.015"
+        }
+
+        /// Gets the number of characters of an unsigned decimal floating-point number of `digitCount` digits in the scientific notation, e.g. "1.5e+20".
+        inline size_t scientificNotationSize(unsigned digitCount, int exponent) noexcept
+        {
+            const int scientificExponent = exponent + static_cast<int>(digitCount) - 1;
+            return digitCount + (digitCount > 1 ? 1 : 0) + 2 + (scientificExponent <= -100 || scientificExponent >= 100 ? 3 : 2);
+        }
+
+        /// Writes an unsigned decimal floating-point number mantissa * 10^exponent of `digitCount` digits in the fixed or the scientific notation.
+        /// Returns the pointer past the last written character.
+        template<typename CharT>
+        CharT* encodeDecimalFloat(CharT* dst, uint64_t mantissa, int exponent, unsigned digitCount, bool scientific) noexcept
+        {
+            if (scientific) {
+                // The digits are written one position further and the leading one is moved in front of the decimal point.
+                encodeDecimalBackward(dst + 1 + digitCount, mantissa);
+                dst[0] = dst[1];
+                if (digitCount > 1) {
+                    dst[1] = '.';
+                    dst += 1 + digitCount;
+                }
+                else {
+                    dst += 1;
+                }
+                const int scientificExponent = exponent + static_cast<int>(digitCount) - 1;
+                const auto absExponent = static_cast<uint32_t>(scientificExponent < 0 ? -scientificExponent : scientificExponent);
+                *(dst++) = 'e';
+                *(dst++) = scientificExponent < 0 ? '-' : '+';
+                if (absExponent >= 100) {
+                    FixedDecimalEncoder<3>::encode(dst, absExponent);
+                    return dst + 3;
+                }
+                FixedDecimalEncoder<2>::encode(dst, absExponent);
+                return dst + 2;
+            }
+            if (exponent >= 0) {
+                encodeDecimalBackward(dst + digitCount, mantissa);
+                dst += digitCount;
+                for (int i = 0; i < exponent; ++i) {
+                    *(dst++) = '0';
+                }
+                return dst;
+            }
+            const unsigned fractionSize = static_cast<unsigned>(-exponent);
+            if (digitCount > fractionSize) {
+                const unsigned integerSize = digitCount - fractionSize;
+                encodeDecimalBackward(dst + 1 + digitCount, mantissa);
+                for (unsigned i = 0; i < integerSize; ++i) {
+                    dst[i] = dst[i + 1];
+                }
+                dst[integerSize] = '.';
+                return dst + 1 + digitCount;
+            }
+            *(dst++) = '0';
+            *(dst++) = '.';
+            for (unsigned i = digitCount; i < fractionSize; ++i) {
+                *(dst++) = '0';
+            }
+            encodeDecimalBackward(dst + digitCount, mantissa);
+            return dst + digitCount;
+        }
+
+        /// Writes the `digitCount` decimal digits of the integer mantissa * 2^shift, which must be below 2^96.
+        template<typename CharT>
+        void encodeShiftedInteger(CharT* dst, uint64_t mantissa, unsigned shift, unsigned digitCount) noexcept
+        {
+            assert(shift <= 32);
+            if (mantissa >> (63 - shift) == 0) {
+                encodeDecimalBackward(dst + digitCount, mantissa << shift);
+                return;
+            }
+            // The value is split into 9 lowest digits and the rest by a long division of its upper bits and then its lowest 32 bits.
+            const uint64_t upper = mantissa >> (32 - shift);
+            const uint64_t lower = (mantissa << shift) & 0xFFFFFFFFu;
+            const uint64_t partial = ((upper % 1000000000u) << 32) | lower;
+            const uint64_t quotient = ((upper / 1000000000u) << 32) + partial / 1000000000u;
+            FixedDecimalEncoder<9>::encode(dst + digitCount - 9, static_cast<uint32_t>(partial % 1000000000u));
+            encodeDecimalBackward(dst + digitCount - 9, quotient);
+        }
+
+        /// Appends a decimal floating-point number in the shorter of the fixed and the scientific notation (fixed if equal), like std::to_chars() does.
+        /// Like std::to_chars(), the fixed notation of a value of binaryMantissa * 2^binaryExponent with binaryExponent > 0 (an integer, beyond the range
+        /// where every integer is representable) shows its exact digits, e.g. "1152921504606846976", rather than the shortest digits padded with zeros.
+        template<size_t MaxSize, typename SB>
+        void appendDecimalFloat(SB& sb, bool negative, DecimalFloat decimal, uint64_t binaryMantissa = 0, int binaryExponent = 0)
+        {
+            using char_type = typename SB::char_type;
+            const unsigned digitCount = countDecimalDigits(decimal.mantissa);
+            const size_t fixedSize = fixedNotationSize(digitCount, decimal.exponent);
+            const size_t scientificSize = scientificNotationSize(digitCount, decimal.exponent);
+            const bool scientific = scientificSize < fixedSize;
+            const size_t size = (scientific ? scientificSize : fixedSize) + (negative ? 1 : 0);
+
+            appendEncoded<MaxSize>(sb, size, [=](char_type* dst) {
+                if (negative) {
+                    *(dst++) = '-';
+                }
+                if (!scientific && binaryExponent > 0) {
+                    encodeShiftedInteger(dst, binaryMantissa, static_cast<unsigned>(binaryExponent), static_cast<unsigned>(fixedSize));
+                }
+                else {
+                    encodeDecimalFloat(dst, decimal.mantissa, decimal.exponent, digitCount, scientific);
+                }
+            });
+        }
+
+        /// Appends "inf", "-inf", "nan" or "-nan" (or their uppercase forms).
+        template<typename SB>
+        void appendNonFinite(SB& sb, bool negative, bool nan, bool upper = false)
+        {
+            using char_type = typename SB::char_type;
+            const char* const text = nan ? (upper ? "-NAN" : "-nan") : (upper ? "-INF" : "-inf");
+            const size_t size = negative ? 4 : 3;
+            appendEncoded<4>(sb, size, [=](char_type* dst) {
+                for (size_t i = 0; i < size; ++i) {
+                    dst[i] = static_cast<char_type>(text[4 - size + i]);
+                }
+            });
+        }
+    }
+
+    /// Doubles are appended in the shortest form which reads back to the same value, in the fixed or the scientific notation, whichever is shorter.
+    /// It is the format of std::to_chars() (e.g. "0.1", "-123.4567", "1e+20", "5e-324", "inf"), independent of the locale.
+    template<typename SB>
+    struct sb_appender<SB, double>
+    {
+        void operator()(SB& sb, double v) const
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            const bool negative = (bits >> 63) != 0;
+            const uint64_t ieeeMantissa = bits & ((uint64_t{1} << 52) - 1);
+            const auto ieeeExponent = static_cast<uint32_t>((bits >> 52) & 0x7FF);
+
+            if (STRINGBUILDER_UNLIKELY(ieeeExponent == 0x7FF)) {
+                detail::appendNonFinite(sb, negative, ieeeMantissa != 0);
+            }
+            else if (ieeeExponent == 0 && ieeeMantissa == 0) {
+                detail::appendDecimalFloat<detail::maxShortestWidth<double>()>(sb, negative, { 0, 0 });
+            }
+            else {
+                const uint64_t binaryMantissa = ieeeExponent == 0 ? ieeeMantissa : (uint64_t{1} << 52) | ieeeMantissa;
+                const int binaryExponent = static_cast<int>(ieeeExponent == 0 ? 1 : ieeeExponent) - 1023 - 52;
+                detail::appendDecimalFloat<detail::maxShortestWidth<double>()>(sb, negative, detail::shortestDecimal64(ieeeMantissa, ieeeExponent), binaryMantissa, binaryExponent);
+            }
+        }
+    };
+
+    /// Floats are appended in the shortest form which reads back to the same float (rather than double), e.g. 0.1f gives "0.1".
+    template<typename SB>
+    struct sb_appender<SB, float>
+    {
+        void operator()(SB& sb, float v) const
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            const bool negative = (bits >> 31) != 0;
+            const uint32_t ieeeMantissa = bits & ((uint32_t{1} << 23) - 1);
+            const uint32_t ieeeExponent = (bits >> 23) & 0xFF;
+
+            if (STRINGBUILDER_UNLIKELY(ieeeExponent == 0xFF)) {
+                detail::appendNonFinite(sb, negative, ieeeMantissa != 0);
+            }
+            else if (ieeeExponent == 0 && ieeeMantissa == 0) {
+                detail::appendDecimalFloat<detail::maxShortestWidth<float>()>(sb, negative, { 0, 0 });
+            }
+            else {
+                const uint32_t binaryMantissa = ieeeExponent == 0 ? ieeeMantissa : (uint32_t{1} << 23) | ieeeMantissa;
+                const int binaryExponent = static_cast<int>(ieeeExponent == 0 ? 1 : ieeeExponent) - 127 - 23;
+                detail::appendDecimalFloat<detail::maxShortestWidth<float>()>(sb, negative, detail::shortestDecimal32(ieeeMantissa, ieeeExponent), binaryMantissa, binaryExponent);
+            }
+        }
+    };
+
+    namespace detail
+    {
+        /// Unsigned integer of up to Capacity 32-bit limbs (little-endian) living on the stack, with just the operations needed for exact decimal conversion.
+        template<size_t Capacity>
+        struct BigUInt
+        {
+            uint32_t limbs[Capacity];
+            size_t size;    // The number of significant limbs, zero for the value of zero.
+
+            explicit BigUInt(uint64_t v) noexcept : size{0}
+            {
+                for (; v != 0; v >>= 32) {
+                    limbs[size++] = static_cast<uint32_t>(v);
+                }
+            }
+
+            bool isOdd() const noexcept { return size > 0 && (limbs[0] & 1) != 0; }
+
+            void trim() noexcept
+            {
+                while (size > 0 && limbs[size - 1] == 0) --size;
+            }
+
+            void multiply(uint32_t factor) noexcept
+            {
+                uint64_t carry = 0;
+                for (size_t i = 0; i < size; ++i) {
+                    const uint64_t product = static_cast<uint64_t>(limbs[i]) * factor + carry;
+                    limbs[i] = static_cast<uint32_t>(product);
+                    carry = product >> 32;
+                }
+                if (carry != 0) {
+                    assert(size < Capacity);
+                    limbs[size++] = static_cast<uint32_t>(carry);
+                }
+            }
+
+            void multiplyByPowerOf10(unsigned exponent) noexcept
+            {
+                for (; exponent >= 9; exponent -= 9) {
+                    multiply(1000000000u);
+                }
+                multiply(static_cast<uint32_t>(PowersOf10<>::table[exponent]));
+            }
+
+            /// Divides the value in place and returns the remainder.
+            uint32_t divide(uint32_t divisor) noexcept
+            {
+                uint64_t remainder = 0;
+                for (size_t i = size; i-- > 0;) {
+                    const uint64_t current = (remainder << 32) | limbs[i];
+                    limbs[i] = static_cast<uint32_t>(current / divisor);
+                    remainder = current % divisor;
+                }
+                trim();
+                return static_cast<uint32_t>(remainder);
+            }
+
+            /// Divides the value in place by 10^exponent and tells whether the remainder is non-zero.
+            bool divideByPowerOf10(unsigned exponent) noexcept
+            {
+                bool inexact = false;
+                for (; exponent >= 9; exponent -= 9) {
+                    inexact |= divide(1000000000u) != 0;
+                }
+                return (divide(static_cast<uint32_t>(PowersOf10<>::table[exponent])) != 0) | inexact;
+            }
+
+            void shiftLeft(unsigned bits) noexcept
+            {
+                if (size == 0)
+                    return;
+                const size_t limbShift = bits / 32;
+                const unsigned bitShift = bits % 32;
+                assert(size + limbShift + 1 <= Capacity);
+                if (bitShift == 0) {
+                    for (size_t i = size; i-- > 0;) {
+                        limbs[i + limbShift] = limbs[i];
+                    }
+                }
+                else {
+                    limbs[size + limbShift] = limbs[size - 1] >> (32 - bitShift);
+                    for (size_t i = size - 1; i > 0; --i) {
+                        limbs[i + limbShift] = (limbs[i] << bitShift) | (limbs[i - 1] >> (32 - bitShift));
+                    }
+                    limbs[limbShift] = limbs[0] << bitShift;
+                }
+                for (size_t i = 0; i < limbShift; ++i) {
+                    limbs[i] = 0;
+                }
+                size += limbShift + (bitShift != 0 ? 1 : 0);
+                trim();
+            }
+
+            /// Shifts the value right in place and tells whether any of the bits shifted out was set.
+            bool shiftRight(unsigned bits) noexcept
+            {
+                const size_t limbShift = bits / 32;
+                const unsigned bitShift = bits % 32;
+                if (limbShift >= size) {
+                    const bool inexact = size != 0;
+                    size = 0;
+                    return inexact;
+                }
+                bool inexact = bitShift != 0 && (limbs[limbShift] & ((uint32_t{1} << bitShift) - 1)) != 0;
+                for (size_t i = 0; i < limbShift; ++i) {
+                    inexact |= limbs[i] != 0;
+                }
+                const size_t newSize = size - limbShift;
+                for (size_t i = 0; i < newSize; ++i) {
+                    const uint32_t upper = i + 1 < newSize && bitShift != 0 ? limbs[i + limbShift + 1] << (32 - bitShift) : 0;
+                    limbs[i] = (limbs[i + limbShift] >> bitShift) | upper;
+                }
+                size = newSize;
+                trim();
+                return inexact;
+            }
+
+            void increment() noexcept
+            {
+                for (size_t i = 0; i < size; ++i) {
+                    if (++limbs[i] != 0)
+                        return;
+                }
+                assert(size < Capacity);
+                limbs[size++] = 1;
+            }
+        };
+
+        /// Splits a finite double into an integer mantissa and a binary exponent, so that |v| = mantissa * 2^exponent.
+        inline void splitBinaryFloat(double v, uint64_t& mantissa, int& exponent) noexcept
+        {
+            uint64_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            const uint64_t ieeeMantissa = bits & ((uint64_t{1} << 52) - 1);
+            const auto ieeeExponent = static_cast<int>((bits >> 52) & 0x7FF);
+            mantissa = ieeeExponent == 0 ? ieeeMantissa : (uint64_t{1} << 52) | ieeeMantissa;
+            exponent = (ieeeExponent == 0 ? 1 : ieeeExponent) - 1023 - 52;
+        }
+
+        /// Computes mantissa * 2^exponent2 * 10^exponent10 rounded to the nearest integer (half to even), exactly.
+        template<size_t Capacity>
+        BigUInt<Capacity> roundScaled(uint64_t mantissa, int exponent2, int exponent10) noexcept
+        {
+            BigUInt<Capacity> n{mantissa};
+            if (exponent10 > 0) {
+                n.multiplyByPowerOf10(static_cast<unsigned>(exponent10));
+            }
+            // Twice the value is truncated, so that its lowest bit tells whether the fraction is at least a half and `inexact` whether it is more than that.
+            n.shiftLeft(static_cast<unsigned>(exponent2 > 0 ? exponent2 + 1 : 1));
+            bool inexact = exponent10 < 0 && n.divideByPowerOf10(static_cast<unsigned>(-exponent10));
+            inexact |= exponent2 < 0 && n.shiftRight(static_cast<unsigned>(-exponent2));
+            const bool half = n.isOdd();
+            n.shiftRight(1);
+            if (half && (inexact || n.isOdd())) {
+                n.increment();
+            }
+            return n;
+        }
+
+        /// Decimal digits of a BigUInt in chunks of 9 digits, the least significant chunk first.
+        template<size_t Capacity>
+        struct DecimalChunks
+        {
+            uint32_t chunks[Capacity * 32 / 29 + 1];
+            size_t count;
+
+            explicit DecimalChunks(BigUInt<Capacity> n) noexcept : count{0}
+            {
+                while (n.size > 2) {
+                    chunks[count++] = n.divide(1000000000u);
+                }
+                uint64_t rest = n.size == 0 ? 0 : n.size == 1 ? n.limbs[0] : (static_cast<uint64_t>(n.limbs[1]) << 32) | n.limbs[0];
+                do {
+                    chunks[count++] = static_cast<uint32_t>(rest % 1000000000u);
+                    rest /= 1000000000u;
+                } while (rest != 0);
+            }
+
+            size_t digitCount() const noexcept { return 9 * (count - 1) + countDecimalDigits(chunks[count - 1]); }
+
+            /// Writes the digits padded with leading zeros to `width` characters, which must be at least digitCount().
+            template<typename CharT>
+            void encode(CharT* dst, size_t width) const noexcept
+            {
+                CharT* end = dst + width;
+                for (size_t i = 0; i + 1 < count; ++i) {
+                    end -= 9;
+                    FixedDecimalEncoder<9>::encode(end, chunks[i]);
+                }
+                end = encodeDecimalBackward(end, chunks[count - 1]);
+                while (end > dst) {
+                    *(--end) = '0';
+                }
+            }
+        };
+
+        /// Gets floor(log10(2^e)) for a binary exponent of a double, positive or negative.
+        inline int floorLog10Pow2(int e) noexcept
+        {
+            return e >= 0 ? log10Pow2(e) : -log10Pow2(-e) - 1;
+        }
+    }
+
+    /// Floating-point number formatted in the fixed notation with Precision digits after the decimal point, created with fixed().
+    template<size_t Precision, typename FloatT>
+    struct fixed_float_t
+    {
+        static_assert(std::is_same<FloatT, double>::value || std::is_same<FloatT, float>::value, "Only float and double are supported");
+
+        /// Maximal number of characters of a formatted value, e.g. "-179769...(309 digits).000".
+        static constexpr size_t max_size = 1 + std::numeric_limits<FloatT>::max_exponent10 + 1 + (Precision > 0 ? 1 + Precision : 0);
+
+        FloatT value;
+    };
+
+    /// Formats a floating-point number with exactly Precision digits after the decimal point, correctly rounded (half to even) and regardless of the locale,
+    /// e.g. fixed<3>(2.0 / 3) gives "0.667", like "%.3f" of printf() does.
+    template<size_t Precision, typename FloatT>
+    constexpr fixed_float_t<Precision, FloatT> fixed(FloatT v) noexcept { return { v }; }
+
+    /// Floating-point number formatted in the scientific notation with Precision digits after the decimal point, created with sci().
+    template<size_t Precision, typename FloatT>
+    struct sci_float_t
+    {
+        static_assert(std::is_same<FloatT, double>::value || std::is_same<FloatT, float>::value, "Only float and double are supported");
+
+        /// Maximal number of characters of a formatted value, e.g. "-1.797e+308".
+        static constexpr size_t max_size = 1 + 1 + (Precision > 0 ? 1 + Precision : 0) + 2 + (std::numeric_limits<FloatT>::max_exponent10 >= 100 ? 3 : 2);
+
+        FloatT value;
+    };
+
+    /// Formats a floating-point number in the scientific notation with Precision digits after the decimal point, correctly rounded (half to even)
+    /// and regardless of the locale, e.g. sci<3>(123456.0) gives "1.235e+05", like "%.3e" of printf() does.
+    template<size_t Precision, typename FloatT>
+    constexpr sci_float_t<Precision, FloatT> sci(FloatT v) noexcept { return { v }; }
+
+    template<typename SB, size_t Precision, typename FloatT>
+    struct sb_appender<SB, fixed_float_t<Precision, FloatT>>
+    {
+        // The largest scaled value is below 2^1024 * 10^Precision.
+        static constexpr size_t capacity = (1024 + 4 * Precision) / 32 + 3;
+
+        void operator()(SB& sb, const fixed_float_t<Precision, FloatT>& ff) const
+        {
+            using char_type = typename SB::char_type;
+            const double v = ff.value;
+            const bool negative = std::signbit(v);
+            if (STRINGBUILDER_UNLIKELY(!std::isfinite(v))) {
+                detail::appendNonFinite(sb, negative, std::isnan(v));
+                return;
+            }
+
+            uint64_t mantissa;
+            int exponent;
+            detail::splitBinaryFloat(v, mantissa, exponent);
+            const detail::DecimalChunks<capacity> digits{detail::roundScaled<capacity>(mantissa, exponent, static_cast<int>(Precision))};
+            const size_t digitCount = std::max(digits.digitCount(), Precision + 1);
+            const size_t size = (negative ? 1 : 0) + digitCount + (Precision > 0 ? 1 : 0);
+
+            detail::appendEncoded<fixed_float_t<Precision, FloatT>::max_size>(sb, size, [&](char_type* dst) {
+                if (negative) {
+                    *(dst++) = '-';
+                }
+                digits.encode(dst, digitCount);
+                if (Precision > 0) {
+                    // Make room for the decimal point by moving the fractional digits one position further.
+                    char_type* const point = dst + digitCount - Precision;
+                    for (size_t i = Precision; i > 0; --i) {
+                        point[i] = point[i - 1];
+                    }
+                    *point = '.';
+                }
+            });
+        }
+    };
+
+    template<typename SB, size_t Precision, typename FloatT>
+    struct sb_appender<SB, sci_float_t<Precision, FloatT>>
+    {
+        // The largest scaled value is below 2^54 * 10^(324 + Precision) (for the smallest subnormal).
+        static constexpr size_t capacity = (1140 + 4 * Precision) / 32 + 3;
+
+        void operator()(SB& sb, const sci_float_t<Precision, FloatT>& sf) const
+        {
+            using char_type = typename SB::char_type;
+            const double v = sf.value;
+            const bool negative = std::signbit(v);
+            if (STRINGBUILDER_UNLIKELY(!std::isfinite(v))) {
+                detail::appendNonFinite(sb, negative, std::isnan(v));
+                return;
+            }
+
+            uint64_t mantissa;
+            int exponent;
+            detail::splitBinaryFloat(v, mantissa, exponent);
+
+            // The decimal exponent is estimated from the binary one and then raised until exactly Precision + 1 digits remain,
+            // which is also how a rounding carry (e.g. 9.99 to 10.0) is taken care of.
+            int exponent10 = mantissa == 0 ? 0 : detail::floorLog10Pow2(exponent + static_cast<int>(detail::log2Floor(mantissa)));
+            detail::DecimalChunks<capacity> digits{detail::roundScaled<capacity>(mantissa, exponent, static_cast<int>(Precision) - exponent10)};
+            while (digits.digitCount() > Precision + 1) {
+                ++exponent10;
+                digits = detail::DecimalChunks<capacity>{detail::roundScaled<capacity>(mantissa, exponent, static_cast<int>(Precision) - exponent10)};
+            }
+            const auto absExponent10 = static_cast<uint32_t>(exponent10 < 0 ? -exponent10 : exponent10);
+            const size_t exponentSize = absExponent10 >= 100 ? 3 : 2;
+            const size_t size = (negative ? 1 : 0) + 1 + (Precision > 0 ? 1 + Precision : 0) + 2 + exponentSize;
+
+            detail::appendEncoded<sci_float_t<Precision, FloatT>::max_size>(sb, size, [&](char_type* dst) {
+                if (negative) {
+                    *(dst++) = '-';
+                }
+                // The digits are written one position further and the leading one is moved in front of the decimal point.
+                digits.encode(dst + 1, Precision + 1);
+                dst[0] = dst[1];
+                if (Precision > 0) {
+                    dst[1] = '.';
+                    dst += 1 + Precision;
+                }
+                dst += 1;
+                *(dst++) = 'e';
+                *(dst++) = exponent10 < 0 ? '-' : '+';
+                if (exponentSize == 3) {
+                    detail::FixedDecimalEncoder<3>::encode(dst, absExponent10);
+                }
+                else {
+                    detail::FixedDecimalEncoder<2>::encode(dst, absExponent10);
+                }
+            });
+        }
+    };
+
+    /// Floating-point number formatted exactly in the hexadecimal notation, created with hexfloat().
+    template<typename FloatT, bool Upper>
+    struct hexfloat_t
+    {
+        static_assert(std::is_same<FloatT, double>::value || std::is_same<FloatT, float>::value, "Only float and double are supported");
+
+        /// Number of hexadecimal digits of the fraction of a normalized value.
+        static constexpr size_t max_fraction_digits = (std::numeric_limits<FloatT>::digits - 1 + 3) / 4;
+        /// Maximal number of characters of a formatted value, e.g. "-0x1.fffffffffffffp-1022".
+        static constexpr size_t max_size = 1 + 2 + 1 + 1 + max_fraction_digits + 2 + (std::numeric_limits<FloatT>::max_exponent >= 1000 ? 4 : 3);
+
+        FloatT value;
+    };
+
+    /// Formats a floating-point number in the hexadecimal notation, like "%a" of printf() does (or "%A" if Upper is set), e.g. hexfloat(3.0) gives "0x1.8p+1".
+    /// The text is exact, so it reads back to the very same value, and much cheaper to produce than a decimal one.
+    /// A float is formatted as the double of the same value.
+    template<bool Upper = false, typename FloatT>
+    constexpr hexfloat_t<FloatT, Upper> hexfloat(FloatT v) noexcept { return { v }; }
+
+    template<typename SB, typename FloatT, bool Upper>
+    struct sb_appender<SB, hexfloat_t<FloatT, Upper>>
+    {
+        void operator()(SB& sb, const hexfloat_t<FloatT, Upper>& hf) const
+        {
+            using char_type = typename SB::char_type;
+            const double v = hf.value;
+            uint64_t bits;
+            std::memcpy(&bits, &v, sizeof(bits));
+            const bool negative = (bits >> 63) != 0;
+            uint64_t fraction = bits & ((uint64_t{1} << 52) - 1);
+            const auto ieeeExponent = static_cast<int>((bits >> 52) & 0x7FF);
+
+            if (STRINGBUILDER_UNLIKELY(ieeeExponent == 0x7FF)) {
+                detail::appendNonFinite(sb, negative, fraction != 0, Upper);
+                return;
+            }
+
+            // Subnormals keep the leading digit of 0 and the exponent of the smallest normal, like printf() does.
+            const int exponent = ieeeExponent != 0 ? ieeeExponent - 1023 : fraction != 0 ? -1022 : 0;
+            size_t fractionDigitCount = fraction != 0 ? 13 : 0;
+            for (; fraction != 0 && (fraction & 0xF) == 0; fraction >>= 4) {
+                --fractionDigitCount;
+            }
+            const auto absExponent = static_cast<uint32_t>(exponent < 0 ? -exponent : exponent);
+            const size_t exponentDigitCount = detail::countDecimalDigits(absExponent);
+            const size_t size = (negative ? 1 : 0) + 3 + (fractionDigitCount > 0 ? 1 + fractionDigitCount : 0) + 2 + exponentDigitCount;
+
+            detail::appendEncoded<hexfloat_t<FloatT, Upper>::max_size>(sb, size, [=](char_type* dst) {
+                if (negative) {
+                    *(dst++) = '-';
+                }
+                *(dst++) = '0';
+                *(dst++) = Upper ? 'X' : 'x';
+                *(dst++) = ieeeExponent != 0 ? '1' : '0';
+                if (fractionDigitCount > 0) {
+                    *(dst++) = '.';
+                    detail::encodeRadixBackward<4, Upper>(dst, dst + fractionDigitCount, fraction);
+                    dst += fractionDigitCount;
+                }
+                *(dst++) = Upper ? 'P' : 'p';
+                *(dst++) = exponent < 0 ? '-' : '+';
+                detail::encodeDecimalBackward(dst + exponentDigitCount, absExponent);
+            });
+        }
+    };
+
+
+#if __cpp_lib_integer_sequence && __cpp_lib_void_t
+#define STRINGBUILDER_SUPPORTS_MAKE_STRING
+
+    template<typename CharT, size_t N, size_t... IX>
+    struct constexpr_str
+    {
     private:
         const std::array<CharT, N> arr;
         const CharT c_str_[N];
@@ -1125,8 +3810,8 @@ namespace STRINGBUILDER_NAMESPACE
         }
 
         template<typename CharT, typename IntegralT>
-        constexpr int estimateTypeSize(type<IntegralT>, std::enable_if_t<std::is_integral<IntegralT>::value && !std::is_same<CharT, IntegralT>::value>* = 0) {
-            return 20;
+        constexpr int estimateTypeSize(type<IntegralT>, std::enable_if_t<IsInteger<IntegralT>::value && !std::is_same<CharT, IntegralT>::value>* = 0) {
+            return maxDecimalWidth<IntegralT>();
         }
 
         template<typename CharT, size_t StrSizeWith0>
@@ -1139,6 +3824,71 @@ namespace STRINGBUILDER_NAMESPACE
             return ExpectedSize;
         }
 
+        /// Gets the number of characters of a decimal representation of an integer (including the minus sign).
+        template<typename IntegralT>
+        constexpr size_t decimalWidth(IntegralT v) {
+            auto magnitude = absoluteValue(v);
+            size_t width = isNegative(v) ? 2 : 1;
+            for (; magnitude >= 10; magnitude /= 10)
+                ++width;
+            return width;
+        }
+
+        template<typename CharT, typename IntegralT, IntegralT V, std::enable_if_t<!std::is_same<CharT, IntegralT>::value, int> = 0>
+        constexpr int estimateTypeSize(type<std::integral_constant<IntegralT, V>>) {
+            return decimalWidth(V);
+        }
+
+        /// A compile-time character is appended as the character itself, like a character of a run-time value is.
+        template<typename CharT, CharT V>
+        constexpr int estimateTypeSize(type<std::integral_constant<CharT, V>>) {
+            return 1;
+        }
+
+        template<typename CharT, unsigned BitsPerDigit, typename IntegerT, size_t MinWidth, bool Upper, bool Prefix>
+        constexpr int estimateTypeSize(type<radix_int_t<BitsPerDigit, IntegerT, MinWidth, Upper, Prefix>>) {
+            return radix_int_t<BitsPerDigit, IntegerT, MinWidth, Upper, Prefix>::max_size;
+        }
+
+        template<typename CharT, size_t Width, char Fill, typename IntegerT>
+        constexpr int estimateTypeSize(type<padded_int_t<Width, Fill, IntegerT>>) {
+            return Width;
+        }
+
+        template<typename CharT, typename IntegerT, typename SeparatorT>
+        constexpr int estimateTypeSize(type<grouped_int_t<IntegerT, SeparatorT>>) {
+            return grouped_int_t<IntegerT, SeparatorT>::max_size;
+        }
+
+        template<typename CharT>
+        constexpr int estimateTypeSize(type<double>) {
+            return maxShortestWidth<double>();
+        }
+
+        template<typename CharT>
+        constexpr int estimateTypeSize(type<float>) {
+            return maxShortestWidth<float>();
+        }
+
+        template<typename CharT, size_t Precision, typename FloatT>
+        constexpr int estimateTypeSize(type<fixed_float_t<Precision, FloatT>>) {
+            return fixed_float_t<Precision, FloatT>::max_size;
+        }
+
+        template<typename CharT, size_t Precision, typename FloatT>
+        constexpr int estimateTypeSize(type<sci_float_t<Precision, FloatT>>) {
+            return sci_float_t<Precision, FloatT>::max_size;
+        }
+
+        template<typename CharT, typename FloatT, bool Upper>
+        constexpr int estimateTypeSize(type<hexfloat_t<FloatT, Upper>>) {
+            return hexfloat_t<FloatT, Upper>::max_size;
+        }
+
+        /// Type whose size is estimated for an argument of type T: references and qualifiers are dropped, except for arrays (string literals).
+        template<typename T>
+        using EstimatedType = std::conditional_t<std::is_array<std::remove_reference_t<T>>::value, std::remove_reference_t<T>, std::remove_cv_t<std::remove_reference_t<T>>>;
+
         template<typename CharT, typename T>
         constexpr int estimateTypeSeqSize(type<T> t) {
             return estimateTypeSize<CharT>(t);
@@ -1183,6 +3933,32 @@ namespace STRINGBUILDER_NAMESPACE
         template<typename CharT, typename IntegralT>
         constexpr std::enable_if_t<std::is_integral<IntegralT>::value && !std::is_same<CharT, IntegralT>::value> stringify(IntegralT) = delete;
 
+        /// Gets the character at the given position of a decimal representation of an integer, which is `width` characters long.
+        template<typename IntegralT>
+        constexpr char decimalCharAt(IntegralT v, size_t width, size_t index) {
+            if (isNegative(v) && index == 0)
+                return '-';
+            auto magnitude = absoluteValue(v);
+            for (size_t i = index + 1; i < width; ++i)
+                magnitude /= 10;
+            return static_cast<char>('0' + magnitude % 10);
+        }
+
+        template<typename IntegralT, IntegralT V, size_t... IX>
+        constexpr std::array<char, sizeof...(IX)> stringify(std::integral_constant<IntegralT, V>, std::index_sequence<IX...>) {
+            return { decimalCharAt(V, sizeof...(IX), IX)... };
+        }
+
+        template<typename CharT, typename IntegralT, IntegralT V, std::enable_if_t<!std::is_same<CharT, IntegralT>::value, int> = 0>
+        constexpr std::array<char, decimalWidth(V)> stringify(std::integral_constant<IntegralT, V> ic) {
+            return stringify(ic, std::make_index_sequence<decimalWidth(V)>());
+        }
+
+        template<typename CharT, CharT V>
+        constexpr std::array<char, 1> stringify(std::integral_constant<CharT, V>) {
+            return { V };
+        }
+
         template<typename CharT, size_t N, size_t... IX>
         constexpr std::array<CharT, sizeof...(IX)> stringify(const CharT(&c)[N], std::index_sequence<IX...>) {
             return { c[IX]... };
@@ -1217,7 +3993,7 @@ namespace STRINGBUILDER_NAMESPACE
             template<typename... TX>
             auto operator()(TX&&... vx) const
             {
-                constexpr size_t estimatedSize = estimateTypeSeqSize<CharT>(type<std::remove_reference_t<std::remove_cv_t<TX>>>{}...);
+                constexpr size_t estimatedSize = estimateTypeSeqSize<CharT>(type<EstimatedType<TX>>{}...);
                 basic_stringbuilder<CharT, estimatedSize, std::char_traits<CharT>, std::allocator<uint8_t>> sb;
                 sb.append_many(std::forward<TX>(vx)...);
                 return sb.str();
@@ -1250,7 +4026,7 @@ namespace STRINGBUILDER_NAMESPACE
     template<typename... TX>
     constexpr auto make_stringbuilder(TX&&... vx)
     {
-        constexpr size_t estimatedSize = detail::estimateTypeSeqSize<char>(detail::type<TX>{}...);
+        constexpr size_t estimatedSize = detail::estimateTypeSeqSize<char>(detail::type<detail::EstimatedType<TX>>{}...);
         stringbuilder<estimatedSize> sb;
         sb.append_many(std::forward<TX>(vx)...);
         return sb;
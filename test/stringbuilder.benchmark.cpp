@@ -4,10 +4,20 @@
 //#define _SILENCE_CXX17_STRSTREAM_DEPRECATION_WARNING
 //#include <strstream>
 #include <iostream>
+#include <iomanip>
+#include <locale>
+#include <cstdio>
 #include <cstddef>
+#include <cmath>
 #include <sstream>
 #include <chrono>
+#include <thread>
 #include <vector>
+#include <fstream>
+#ifdef STRINGBUILDER_SUPPORTS_IOVEC
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #ifdef WIN32
 #include <intrin.h>
 #endif
@@ -19,6 +29,11 @@ using namespace sbldr::detail;
 volatile size_t vsize;
 volatile const char* vcstr;
 
+void ProvideResult(size_t size)
+{
+    vsize = size;
+}
+
 void ProvideResult(std::string&& str)
 {
     vsize = str.size();
@@ -36,7 +51,7 @@ void ProvideResult(std::basic_string_view<char>&& str_view)
 enum class BenchmarkTiming { Mean, Best };
 
 template<typename MethodT>
-void Benchmark(const std::string& title, BenchmarkTiming timing, const size_t iterCount, const size_t microIterCount, MethodT method)
+std::chrono::high_resolution_clock::duration Benchmark(const std::string& title, BenchmarkTiming timing, const size_t iterCount, const size_t microIterCount, MethodT method)
 {
     using Clock = std::chrono::high_resolution_clock;
 
@@ -77,8 +92,16 @@ void Benchmark(const std::string& title, BenchmarkTiming timing, const size_t it
     {
         std::cout << "    " << title << ": " << std::chrono::duration_cast<std::chrono::microseconds>(meanDuration).count() << " us " << timingText << std::endl;
     }
+
+    return meanDuration;
 };
 
+void ReportThroughput(std::chrono::high_resolution_clock::duration duration, size_t valueCount, size_t byteCount)
+{
+    const double seconds = std::chrono::duration<double>(duration).count();
+    printf("        %.1f Mvalues/s, %.2f GB/s\n", valueCount / seconds / 1e6, byteCount / seconds / 1e9);
+}
+
 
 void benchmarkIntegerSequence()
 {
@@ -157,6 +180,15 @@ void benchmarkIntegerSequence()
         return ss.str();
     });
 
+    Benchmark("static stringbuilder<> with clear()", BenchmarkTiming::Best, iterCount, 1, [=]() {
+        static stringbuilder<> sb;
+        sb.clear();
+        for (int i = -span; i <= span; ++i) {
+            sb << i << ' ';
+        }
+        return sb.str();
+    });
+
     // {
     //     constexpr int bufSize = 8788 + 1;
     //     char buf[bufSize];
@@ -172,9 +204,665 @@ void benchmarkIntegerSequence()
 }
 
 
+// Reference encoder: one digit per division, gathered in a reversed in-place builder (the original implementation of sb_appender).
+template<typename SB, typename IntegerT>
+void appendIntegerDigitByDigit(SB& sb, IntegerT iv)
+{
+    basic_inplace_stringbuilder<char, maxDecimalWidth<IntegerT>(), false> bss;
+    if (iv >= 0) {
+        do {
+            bss.append(static_cast<char>('0' + iv % 10));
+            iv /= 10;
+        } while (iv > 0);
+    }
+    else {
+        do {
+            bss.append(static_cast<char>('0' - iv % 10));
+            iv /= 10;
+        } while (iv < 0);
+        bss.append('-');
+    }
+    sb.append(bss);
+}
+
+template<typename IntegerT>
+std::vector<IntegerT> makeIntegerSamples(size_t count)
+{
+    std::vector<IntegerT> samples;
+    samples.reserve(count);
+    uint64_t x = 0x9E3779B97F4A7C15ull;
+    for (size_t i = 0; i < count; ++i) {
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        // Vary the magnitude, so that all digit counts are represented.
+        samples.push_back(static_cast<IntegerT>(x >> (x % (8 * sizeof(IntegerT)))));
+    }
+    return samples;
+}
+
+template<typename IntegerT>
+void benchmarkIntegerWidth(const std::string& typeName)
+{
+    constexpr size_t iterCount = 300;
+    const auto samples = makeIntegerSamples<IntegerT>(1000);
+
+    Benchmark(typeName + ": stringbuilder<> << digit-by-digit", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const IntegerT v : samples) {
+            appendIntegerDigitByDigit(sb, v);
+            sb << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark(typeName + ": stringbuilder<> << digit-pairs", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const IntegerT v : samples) {
+            sb << v << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark(typeName + ": string.append(to_string)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        std::string s;
+        for (const IntegerT v : samples) {
+            s.append(std::to_string(v)).append(1, ' ');
+        }
+        return s;
+    });
+}
+
+void benchmarkIntegerWidths()
+{
+    std::cout << "Scenario: IntegerWidths" << std::endl;
+
+    benchmarkIntegerWidth<int8_t>("int8_t");
+    benchmarkIntegerWidth<uint16_t>("uint16_t");
+    benchmarkIntegerWidth<int32_t>("int32_t");
+    benchmarkIntegerWidth<uint32_t>("uint32_t");
+    benchmarkIntegerWidth<int64_t>("int64_t");
+    benchmarkIntegerWidth<uint64_t>("uint64_t");
+}
+
+#ifdef STRINGBUILDER_SUPPORTS_INT128
+void benchmarkInt128()
+{
+    std::cout << "Scenario: Int128" << std::endl;
+
+    constexpr size_t iterCount = 300;
+    const auto upper = makeIntegerSamples<uint64_t>(1000);
+    const auto lower = makeIntegerSamples<uint64_t>(1001);
+    std::vector<Int128> samples;
+    for (size_t i = 0; i < upper.size(); ++i) {
+        // Mix full-width values with ones fitting in 64 bits, alternating the sign.
+        const Int128 v = static_cast<Int128>((static_cast<UInt128>(upper[i] >> 1) << 64) | lower[i + 1]);
+        samples.push_back(i % 3 == 0 ? static_cast<Int128>(lower[i]) : (i % 2 ? -v : v));
+    }
+
+    Benchmark("int128: stringbuilder<> << digit-by-digit", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const Int128 v : samples) {
+            appendIntegerDigitByDigit(sb, v);
+            sb << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("int128: stringbuilder<> << 19-digit limbs", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const Int128 v : samples) {
+            sb << v << ' ';
+        }
+        return sb.str();
+    });
+}
+#endif
+
+void benchmarkPadded()
+{
+    std::cout << "Scenario: Padded" << std::endl;
+
+    constexpr size_t iterCount = 300;
+    const auto samples = makeIntegerSamples<uint32_t>(1000);
+
+    Benchmark("stringbuilder<> << padded<N>(*)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const uint32_t v : samples) {
+            sb << padded<2>(v % 24) << ':' << padded<2>(v % 60) << ':' << padded<2>(v % 59) << '.' << padded<6>(v % 1000000) << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("stringbuilder<> << append(count, '0') << *", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        const auto appendPadded = [&sb](uint32_t value, uint32_t width) {
+            uint32_t digits = 1;
+            for (uint32_t x = value; x >= 10; x /= 10) ++digits;
+            if (digits < width) sb.append(width - digits, '0');
+            sb << value;
+        };
+        for (const uint32_t v : samples) {
+            appendPadded(v % 24, 2); sb << ':';
+            appendPadded(v % 60, 2); sb << ':';
+            appendPadded(v % 59, 2); sb << '.';
+            appendPadded(v % 1000000, 6); sb << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("string.append(snprintf(%02u))", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        std::string s;
+        char buf[32];
+        for (const uint32_t v : samples) {
+            const int n = snprintf(buf, sizeof(buf), "%02u:%02u:%02u.%06u ", v % 24, v % 60, v % 59, v % 1000000);
+            s.append(buf, static_cast<size_t>(n));
+        }
+        return s;
+    });
+}
+
+void benchmarkHexadecimal()
+{
+    std::cout << "Scenario: Hexadecimal" << std::endl;
+
+    constexpr size_t iterCount = 300;
+    const auto samples = makeIntegerSamples<uint64_t>(1000);
+
+    Benchmark("stringbuilder<> << hex(*)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const uint64_t v : samples) {
+            sb << hex(v) << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("stringbuilder<> << hex<16, false, true>(*)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const uint64_t v : samples) {
+            sb << hex<16, false, true>(v) << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("string.append(snprintf(%016llx))", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        std::string s;
+        char buf[32];
+        for (const uint64_t v : samples) {
+            const int n = snprintf(buf, sizeof(buf), "0x%016llx ", static_cast<unsigned long long>(v));
+            s.append(buf, static_cast<size_t>(n));
+        }
+        return s;
+    });
+
+    Benchmark("stringstream << hex << setw(16)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        std::stringstream ss;
+        ss << std::hex << std::setfill('0');
+        for (const uint64_t v : samples) {
+            ss << "0x" << std::setw(16) << v << ' ';
+        }
+        return ss.str();
+    });
+}
+
+template<typename IntegerT>
+void benchmarkAppendRange(const std::string& typeName)
+{
+    constexpr size_t iterCount = 300;
+    const auto samples = makeIntegerSamples<IntegerT>(10000);
+    const size_t byteCount = [&]() { stringbuilder<> sb; sb.append_range(samples.begin(), samples.end(), ','); return sb.size(); }();
+
+    const auto oneByOne = Benchmark(typeName + ": stringbuilder<> << * << ','", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (size_t i = 0; i < samples.size(); ++i) {
+            if (i > 0) sb << ',';
+            sb << samples[i];
+        }
+        return sb.str();
+    });
+    ReportThroughput(oneByOne, samples.size(), byteCount);
+
+    const auto range = Benchmark(typeName + ": stringbuilder<>.append_range(*, ',')", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        sb.append_range(samples.begin(), samples.end(), ',');
+        return sb.str();
+    });
+    ReportThroughput(range, samples.size(), byteCount);
+}
+
+void benchmarkAppendRanges()
+{
+    std::cout << "Scenario: AppendRange" << std::endl;
+
+    benchmarkAppendRange<uint32_t>("uint32_t");
+    benchmarkAppendRange<uint64_t>("uint64_t");
+}
+
+std::vector<double> makeDoubleSamples(size_t count)
+{
+    std::vector<double> samples;
+    samples.reserve(count);
+    const auto mantissas = makeIntegerSamples<uint32_t>(count);
+    for (size_t i = 0; i < count; ++i) {
+        // Metric-like values: a few significant digits at various scales, with occasional full-precision ones.
+        const double scale = std::pow(10.0, static_cast<int>(mantissas[i] % 13) - 6);
+        samples.push_back(i % 4 == 0 ? mantissas[i] / 3.0 * scale : (mantissas[i] % 100000) * scale);
+    }
+    return samples;
+}
+
+void benchmarkDouble()
+{
+    std::cout << "Scenario: Double" << std::endl;
+
+    constexpr size_t iterCount = 300;
+    const auto samples = makeDoubleSamples(1000);
+
+    Benchmark("stringbuilder<> << * (shortest)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const double v : samples) {
+            sb << v << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("stringbuilder<> << to_string(*)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const double v : samples) {
+            sb << std::to_string(v) << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("string.append(snprintf(%.17g))", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        std::string s;
+        char buf[32];
+        for (const double v : samples) {
+            const int n = snprintf(buf, sizeof(buf), "%.17g ", v);
+            s.append(buf, static_cast<size_t>(n));
+        }
+        return s;
+    });
+
+    Benchmark("stringstream << setprecision(17) << *", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        std::stringstream ss;
+        ss << std::setprecision(17);
+        for (const double v : samples) {
+            ss << v << ' ';
+        }
+        return ss.str();
+    });
+}
+
+void benchmarkFloat()
+{
+    std::cout << "Scenario: Float" << std::endl;
+
+    constexpr size_t iterCount = 300;
+    const auto doubleSamples = makeDoubleSamples(1000);
+    const std::vector<float> samples(doubleSamples.begin(), doubleSamples.end());
+
+    Benchmark("stringbuilder<> << float (shortest float)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const float v : samples) {
+            sb << v << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("stringbuilder<> << double(float) (shortest double)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const float v : samples) {
+            sb << static_cast<double>(v) << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("string.append(snprintf(%.9g))", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        std::string s;
+        char buf[32];
+        for (const float v : samples) {
+            const int n = snprintf(buf, sizeof(buf), "%.9g ", static_cast<double>(v));
+            s.append(buf, static_cast<size_t>(n));
+        }
+        return s;
+    });
+}
+
+void benchmarkHexfloat()
+{
+    std::cout << "Scenario: Hexfloat" << std::endl;
+
+    constexpr size_t iterCount = 300;
+    const auto samples = makeDoubleSamples(1000);
+
+    Benchmark("stringbuilder<> << hexfloat(*)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const double v : samples) {
+            sb << hexfloat(v) << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("stringbuilder<> << * (shortest)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const double v : samples) {
+            sb << v << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("string.append(snprintf(%a))", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        std::string s;
+        char buf[32];
+        for (const double v : samples) {
+            const int n = snprintf(buf, sizeof(buf), "%a ", v);
+            s.append(buf, static_cast<size_t>(n));
+        }
+        return s;
+    });
+}
+
+void benchmarkFixedPrecision()
+{
+    std::cout << "Scenario: FixedPrecision" << std::endl;
+
+    constexpr size_t iterCount = 300;
+    const auto samples = makeDoubleSamples(1000);
+
+    Benchmark("stringbuilder<> << fixed<3>(*)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const double v : samples) {
+            sb << fixed<3>(v) << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("string.append(snprintf(%.3f))", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        std::string s;
+        char buf[512];
+        for (const double v : samples) {
+            const int n = snprintf(buf, sizeof(buf), "%.3f ", v);
+            s.append(buf, static_cast<size_t>(n));
+        }
+        return s;
+    });
+
+    Benchmark("stringbuilder<> << sci<6>(*)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const double v : samples) {
+            sb << sci<6>(v) << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("string.append(snprintf(%.6e))", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        std::string s;
+        char buf[32];
+        for (const double v : samples) {
+            const int n = snprintf(buf, sizeof(buf), "%.6e ", v);
+            s.append(buf, static_cast<size_t>(n));
+        }
+        return s;
+    });
+
+    Benchmark("stringstream << fixed << setprecision(3) << *", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(3);
+        for (const double v : samples) {
+            ss << v << ' ';
+        }
+        return ss.str();
+    });
+}
+
+struct ThousandsPunct : std::numpunct<char>
+{
+    char do_thousands_sep() const override { return ','; }
+    std::string do_grouping() const override { return "\3"; }
+};
+
+void benchmarkGrouped()
+{
+    std::cout << "Scenario: Grouped" << std::endl;
+
+    constexpr size_t iterCount = 300;
+    const auto samples = makeIntegerSamples<int64_t>(1000);
+
+    Benchmark("stringbuilder<> << grouped(*)", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        stringbuilder<> sb;
+        for (const int64_t v : samples) {
+            sb << grouped(v) << ' ';
+        }
+        return sb.str();
+    });
+
+    Benchmark("stringstream.imbue(numpunct) << *", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        std::stringstream ss;
+        ss.imbue(std::locale(std::locale::classic(), new ThousandsPunct));
+        for (const int64_t v : samples) {
+            ss << v << ' ';
+        }
+        return ss.str();
+    });
+}
+
+
 std::array<const char*, 33> words{ "There", " ", "are", " ", "only", " ", "10", " ", "people", " ", "in", " ", "the", " ", "world", ":", " ", "those", " ", "who", " ", "know", " ", "binary", " ", "and", " ", "those", " ", "who", " ", "don't", "." };
 const char* g_joke = nullptr;
 
+void benchmarkSizeQuery()
+{
+    std::cout << "Scenario: SizeQuery" << std::endl;
+
+    constexpr size_t iterCount = 100;
+    constexpr size_t targetSize = 4 * 1024 * 1024;
+    const size_t jokeLength = std::char_traits<char>::length(g_joke);
+
+    Benchmark("stringbuilder<> append while size() < 4M", BenchmarkTiming::Best, iterCount, 1, [=]() {
+        stringbuilder<> sb;
+        while (sb.size() < targetSize) {
+            sb.append(g_joke, jokeLength);
+        }
+        return sb.size();
+    });
+
+    Benchmark("stringbuilder<> append while counted < 4M", BenchmarkTiming::Best, iterCount, 1, [=]() {
+        stringbuilder<> sb;
+        size_t size = 0;
+        while (size < targetSize) {
+            sb.append(g_joke, jokeLength);
+            size += jokeLength;
+        }
+        return size;
+    });
+
+    Benchmark("string.append while size() < 4M", BenchmarkTiming::Best, iterCount, 1, [=]() {
+        std::string s;
+        while (s.size() < targetSize) {
+            s.append(g_joke, jokeLength);
+        }
+        return s.size();
+    });
+}
+
+template<typename SB>
+void benchmarkChunkAllocation(const std::string& title, size_t threadCount)
+{
+    using Clock = std::chrono::high_resolution_clock;
+    constexpr size_t builderCount = 200000;
+    const size_t jokeLength = std::char_traits<char>::length(g_joke);
+
+    // Each builder outgrows its in-place area and allocates 3 chunks: of 128, 256 and 512 bytes.
+    auto buildMany = [=]() {
+        size_t totalSize = 0;
+        for (size_t i = 0; i < builderCount; ++i) {
+            SB sb;
+            for (int j = 0; j < 4; ++j) {
+                sb.append(g_joke, jokeLength);
+            }
+            totalSize += sb.size();
+        }
+        ProvideResult(totalSize);
+    };
+
+    const auto time0 = Clock::now();
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; ++t) {
+        threads.emplace_back(buildMany);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - time0).count();
+
+    printf("    %s, %zu thread(s): %.1f M chunk allocations/s\n", title.c_str(), threadCount, 3.0 * builderCount * threadCount / seconds / 1e6);
+}
+
+void benchmarkChunkPool()
+{
+    std::cout << "Scenario: ChunkPool" << std::endl;
+
+    for (const size_t threadCount : { 1, 4 }) {
+        benchmarkChunkAllocation<stringbuilder<16>>("stringbuilder<16>", threadCount);
+        benchmarkChunkAllocation<pooled_stringbuilder<16>>("pooled_stringbuilder<16>", threadCount);
+    }
+}
+
+void benchmarkHugePages()
+{
+    std::cout << "Scenario: HugePages" << std::endl;
+
+    // The size is kept moderate for the test runs; the gain of huge pages grows with it, e.g. 1 GiB shows it best.
+    constexpr size_t iterCount = 5;
+    constexpr size_t totalSize = 64 * 1024 * 1024;
+    const size_t jokeLength = std::char_traits<char>::length(g_joke);
+
+    Benchmark("stringbuilder<> build + str()", BenchmarkTiming::Best, iterCount, 1, [=]() {
+        stringbuilder<> sb;
+        for (size_t size = 0; size < totalSize; size += jokeLength) {
+            sb.append(g_joke, jokeLength);
+        }
+        return sb.str();
+    });
+
+    Benchmark("stringbuilder<> with huge_page_allocator build + str()", BenchmarkTiming::Best, iterCount, 1, [=]() {
+        stringbuilder<0, std::char_traits<char>, huge_page_allocator<char>> sb;
+        for (size_t size = 0; size < totalSize; size += jokeLength) {
+            sb.append(g_joke, jokeLength);
+        }
+        return sb.str();
+    });
+}
+
+#ifdef STRINGBUILDER_SUPPORTS_IOVEC
+template<typename SB>
+void benchmarkWriteTo(const std::string& title, const std::string& target, int fd)
+{
+    constexpr size_t iterCount = 50;
+    constexpr size_t totalSize = 4 * 1024 * 1024;
+    const size_t jokeLength = std::char_traits<char>::length(g_joke);
+
+    SB sb;
+    for (size_t size = 0; size < totalSize; size += jokeLength) {
+        sb.append(g_joke, jokeLength);
+    }
+
+    Benchmark(title + ".write_to(" + target + ")", BenchmarkTiming::Best, iterCount, 1, [&]() {
+        sb.write_to(fd);
+        return sb.size();
+    });
+
+    std::ofstream out{"/dev/fd/" + std::to_string(fd), std::ios::binary};
+    Benchmark("ofstream(" + target + ") << " + title, BenchmarkTiming::Best, iterCount, 1, [&]() {
+        out << sb;
+        out.flush();
+        return sb.size();
+    });
+}
+
+void benchmarkWriteTo()
+{
+    std::cout << "Scenario: WriteTo" << std::endl;
+
+    const int devNull = ::open("/dev/null", O_WRONLY);
+    benchmarkWriteTo<stringbuilder<>>("stringbuilder<>", "/dev/null", devNull);
+    benchmarkWriteTo<stringbuilder<0, std::char_traits<char>, std::allocator<char>, page_growth<4096>>>("stringbuilder<page_growth<4096>>", "/dev/null", devNull);
+    ::close(devNull);
+
+    // Another thread drains the pipe as fast as it can.
+    int fds[2];
+    if (::pipe(fds) != 0)
+        return;
+    std::thread reader{[=]() {
+        static char buffer[64 * 1024];
+        while (::read(fds[0], buffer, sizeof(buffer)) > 0) {}
+    }};
+    benchmarkWriteTo<stringbuilder<>>("stringbuilder<>", "pipe", fds[1]);
+    benchmarkWriteTo<stringbuilder<0, std::char_traits<char>, std::allocator<char>, page_growth<4096>>>("stringbuilder<page_growth<4096>>", "pipe", fds[1]);
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+}
+#endif
+
+template<typename T>
+size_t fillAndReverse(std::vector<T>& rows, size_t rowCount)
+{
+    const size_t jokeLength = std::char_traits<char>::length(g_joke);
+    for (size_t i = 0; i < rowCount; ++i) {
+        rows.emplace_back();
+        rows.back().append("row " + std::to_string(i) + ": ");
+        if (i % 4 == 0)
+            rows.back().append(g_joke, jokeLength);
+    }
+    std::reverse(rows.begin(), rows.end());
+    return rows.front().size();
+}
+
+void benchmarkBuilderVector()
+{
+    std::cout << "Scenario: BuilderVector" << std::endl;
+
+    // The vector is grown without reserve(), so the builders are moved on every reallocation and swapped by reverse().
+    constexpr size_t iterCount = 200;
+    constexpr size_t rowCount = 10000;
+
+    Benchmark("vector<stringbuilder<32>> emplace_back + reverse", BenchmarkTiming::Best, iterCount, 1, [=]() {
+        std::vector<stringbuilder<32>> rows;
+        return fillAndReverse(rows, rowCount);
+    });
+
+    Benchmark("vector<string> emplace_back + reverse", BenchmarkTiming::Best, iterCount, 1, [=]() {
+        std::vector<std::string> rows;
+        return fillAndReverse(rows, rowCount);
+    });
+}
+
+template<typename SB>
+void appendBookSentences(SB& sb, size_t wordCount)
+{
+    for (size_t i = 0; i < wordCount; i += words.size()) {
+        sb << "There" << " " << "are" << " " << "only" << " " << "10" << " " << "people" << " " << "in" << " " << "the" << " " << "world" << ":" << " " << "those" << " " << "who" << " " << "know" << " " << "binary" << " " << "and" << " " << "those" << " " << "who" << " " << "don't" << "." << " ";
+    }
+}
+
+template<typename GrowthPolicy>
+void prepareGrowthPolicy(GrowthPolicy&) {}
+
+void prepareGrowthPolicy(hinted_growth& growthPolicy) { growthPolicy.expect(1000000); }
+
+template<typename GrowthPolicy>
+void benchmarkBookGrowthPolicy(const std::string& title, size_t iterCount, size_t miniIterCount, size_t wordCount)
+{
+    Benchmark(title, BenchmarkTiming::Best, iterCount, miniIterCount, [=]() {
+        stringbuilder<0, std::char_traits<char>, std::allocator<char>, GrowthPolicy> sb;
+        prepareGrowthPolicy(sb.growth_policy());
+        for (size_t i = 0; i < wordCount; i += words.size()) {
+            sb << "There" << " " << "are" << " " << "only" << " " << "10" << " " << "people" << " " << "in" << " " << "the" << " " << "world" << ":" << " " << "those" << " " << "who" << " " << "know" << " " << "binary" << " " << "and" << " " << "those" << " " << "who" << " " << "don't" << "." << " ";
+        }
+        return sb.str();
+    });
+}
+
 void benchmarkBook()
 {
     std::cout << "Scenario: Book" << std::endl;
@@ -230,6 +918,37 @@ void benchmarkBook()
         return sb.str();
     });
 
+    benchmarkBookGrowthPolicy<geometric_growth<3, 2>>("stringbuilder<> growing x1.5 << [N]", iterCount, miniIterCount, wordCount);
+    benchmarkBookGrowthPolicy<geometric_growth<2, 1, 64 * 1024>>("stringbuilder<> growing x2 up to 64kB << [N]", iterCount, miniIterCount, wordCount);
+    benchmarkBookGrowthPolicy<page_growth<4 * 1024>>("stringbuilder<> in 4kB pages << [N]", iterCount, miniIterCount, wordCount);
+    benchmarkBookGrowthPolicy<page_growth<64 * 1024>>("stringbuilder<> in 64kB pages << [N]", iterCount, miniIterCount, wordCount);
+    benchmarkBookGrowthPolicy<hinted_growth>("stringbuilder<> with hint << [N]", iterCount, miniIterCount, wordCount);
+
+#ifdef STRINGBUILDER_SUPPORTS_PMR
+    // A per-request arena: the buffer is allocated once and the resource on top of it is rewound at every iteration.
+    auto arenaBuffer = std::vector<char>(4 * 1024 * 1024);
+
+    Benchmark("pmr::stringbuilder<> on new_delete_resource << [N]", BenchmarkTiming::Best, iterCount, miniIterCount, [=]() {
+        pmr::stringbuilder<> sb{std::pmr::new_delete_resource()};
+        appendBookSentences(sb, wordCount);
+        return sb.str();
+    });
+
+    Benchmark("pmr::stringbuilder<> on monotonic_buffer_resource << [N]", BenchmarkTiming::Best, iterCount, miniIterCount, [&]() {
+        std::pmr::monotonic_buffer_resource arena{arenaBuffer.data(), arenaBuffer.size()};
+        pmr::stringbuilder<> sb{&arena};
+        appendBookSentences(sb, wordCount);
+        return sb.str();
+    });
+
+    Benchmark("pmr::arena_stringbuilder<> on monotonic_buffer_resource << [N]", BenchmarkTiming::Best, iterCount, miniIterCount, [&]() {
+        std::pmr::monotonic_buffer_resource arena{arenaBuffer.data(), arenaBuffer.size()};
+        pmr::arena_stringbuilder<> sb{&arena};
+        appendBookSentences(sb, wordCount);
+        return sb.str();
+    });
+#endif
+
     //Benchmark("stringbuilder<4kB> << *", BenchmarkTiming::Best, iterCount, miniIterCount, [=]() {
     //    stringbuilder<4 * 1024> sb;
     //    for (size_t i = 0; i < wordCount; ++i) {
@@ -262,6 +981,13 @@ void benchmarkBook()
         return sb.str();
     });
 
+    Benchmark("stringbuilder<> over 64kB scratch buffer << [N]", BenchmarkTiming::Best, iterCount, miniIterCount, [=]() {
+        static thread_local char scratch[64 * 1024];
+        stringbuilder<> sb{scratch, sizeof(scratch)};
+        appendBookSentences(sb, wordCount);
+        return sb.str();
+    });
+
     //Benchmark("stringbuilder<512kB> << *", BenchmarkTiming::Best, iterCount, miniIterCount, [=]() {
     //    stringbuilder<512 * 1024> sb;
     //    for (size_t i = 0; i < wordCount; ++i) {
@@ -451,6 +1177,51 @@ void benchmarkQuote()
         return sb.str();
     });
 
+    // The result is kept in a long-lived string: assigning str() allocates a new string every time, while assign_to() reuses the capacity.
+    Benchmark("stringbuilder<81>(*) => static string = str()", BenchmarkTiming::Mean, iterCount, miniIterCount, [=]() {
+        static std::string text;
+        stringbuilder<81> sb;
+        for (const char* word : words)
+        {
+            sb << word;
+        }
+        text = sb.str();
+        return text.size();
+    });
+
+    Benchmark("stringbuilder<81>(*) => assign_to(static string)", BenchmarkTiming::Mean, iterCount, miniIterCount, [=]() {
+        static std::string text;
+        stringbuilder<81> sb;
+        for (const char* word : words)
+        {
+            sb << word;
+        }
+        sb.assign_to(text);
+        return text.size();
+    });
+
+    Benchmark("inplace_stringbuilder<81>(*) => static string = str()", BenchmarkTiming::Mean, iterCount, miniIterCount, [=]() {
+        static std::string text;
+        inplace_stringbuilder<81> sb;
+        for (const char* word : words)
+        {
+            sb << word;
+        }
+        text = sb.str();
+        return text.size();
+    });
+
+    Benchmark("inplace_stringbuilder<81>(*) => assign_to(static string)", BenchmarkTiming::Mean, iterCount, miniIterCount, [=]() {
+        static std::string text;
+        inplace_stringbuilder<81> sb;
+        for (const char* word : words)
+        {
+            sb << word;
+        }
+        sb.assign_to(text);
+        return text.size();
+    });
+
     Benchmark("string + string (loop)", BenchmarkTiming::Mean, iterCount, miniIterCount, [=]() {
         std::string text;
         for (const char* word : words)
@@ -922,6 +1693,12 @@ struct SbTR2
 };
 
 
+// The shipped builder, with the space reserved up front like the reference implementations above do.
+struct SbShipped : public stringbuilder<>
+{
+    explicit SbShipped(size_t reserveSize) { reserve(reserveSize); }
+};
+
 template<typename SbT>
 void benchmarkAppend(const std::string& title)
 {
@@ -986,6 +1763,9 @@ void benchmarkAppend()
     benchmarkAppend<SbTR<false, true>>("if(likely spaceLeft) tail++");
     benchmarkAppend<SbTR<true, true>>("prefetch if(likely spaceLeft) tail++");
 #endif
+    std::cout << std::endl;
+
+    benchmarkAppend<SbShipped>("stringbuilder<>");
 }
 
 
@@ -1159,6 +1939,25 @@ int main(const int argc, const char* const argv[])
 
     do {
         benchmarkIntegerSequence();
+        benchmarkIntegerWidths();
+#ifdef STRINGBUILDER_SUPPORTS_INT128
+        benchmarkInt128();
+#endif
+        benchmarkPadded();
+        benchmarkHexadecimal();
+        benchmarkGrouped();
+        benchmarkAppendRanges();
+        benchmarkDouble();
+        benchmarkFloat();
+        benchmarkHexfloat();
+        benchmarkFixedPrecision();
+        benchmarkSizeQuery();
+        benchmarkChunkPool();
+        benchmarkHugePages();
+#ifdef STRINGBUILDER_SUPPORTS_IOVEC
+        benchmarkWriteTo();
+#endif
+        benchmarkBuilderVector();
         benchmarkBook();
         benchmarkQuote();
         benchmarkAppend();
@@ -1,5 +1,11 @@
 ﻿
 #include <stringbuilder.h>
+#include <algorithm>
+#include <vector>
+#ifdef STRINGBUILDER_SUPPORTS_IOVEC
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #define CATCH_CONFIG_MAIN
 #include "catch.hpp"
 
@@ -60,14 +66,255 @@ TEST_CASE("inplace_stringbuilder.EncodeInteger", "[inplace_stringbuilder]")
     }
 }
 
+TEST_CASE("inplace_stringbuilder.EncodeIntegerTypes", "[inplace_stringbuilder]")
+{
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << int8_t{-128} << ' ' << uint8_t{255} << ' ' << int16_t{-32768} << ' ' << uint16_t{65535};
+        REQUIRE(std::to_string(sb) == "-128 255 -32768 65535");
+    }
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << std::numeric_limits<int32_t>::min() << ' ' << std::numeric_limits<uint32_t>::max();
+        REQUIRE(std::to_string(sb) == "-2147483648 4294967295");
+    }
+    for (uint64_t v = 1, i = 0; i < 20; v *= 10, ++i) {
+        for (uint64_t probe : { v - 1, v, v + 1, 2 * v - 1 }) {
+            auto sb = inplace_stringbuilder<20>{};
+            sb << probe;
+            REQUIRE(std::to_string(sb) == std::to_string(probe));
+        }
+    }
+}
+
+TEST_CASE("inplace_stringbuilder.EncodeIntegerOverflow", "[inplace_stringbuilder]")
+{
+    {   auto sb = inplace_stringbuilder<5, true, std::char_traits<char>, inplace_stringbuilder_overflow_polcy::protect>{};
+        sb << "ab" << 12345;
+        REQUIRE(sb.str() == "ab123");
+    }
+    {   auto sb = inplace_stringbuilder<5, true, std::char_traits<char>, inplace_stringbuilder_overflow_polcy::early_exception>{};
+        sb << "ab";
+        REQUIRE_THROWS_AS(sb << -1234, inplace_stringbuilder_early_overflow_error);
+        REQUIRE(sb.str() == "ab");
+    }
+    {   auto sb = inplace_stringbuilder<5, true, std::char_traits<char>, inplace_stringbuilder_overflow_polcy::late_exception>{};
+        sb << "ab";
+        REQUIRE_THROWS_AS(sb << -1234, inplace_stringbuilder_late_overflow_error);
+        REQUIRE(sb.str() == "ab-12");
+    }
+}
+
+TEST_CASE("inplace_stringbuilder.Claim", "[inplace_stringbuilder]")
+{
+    {   auto sb = inplace_stringbuilder<8>{};
+        sb << "ab";
+        std::char_traits<char>::copy(sb.claim(3), "xyz", 3);
+        sb << 'c';
+        REQUIRE(std::to_string(sb) == "abxyzc");
+    }
+    {   auto sb = inplace_stringbuilder<8, false>{};
+        sb << "ab";
+        std::char_traits<char>::copy(sb.claim(3), "xyz", 3);
+        sb << 'c';
+        REQUIRE(std::to_string(sb) == "cxyzab");
+    }
+    {   auto sb = inplace_stringbuilder<4, true, std::char_traits<char>, inplace_stringbuilder_overflow_polcy::protect>{};
+        sb << "ab";
+        REQUIRE(sb.claim(3) == nullptr);
+        REQUIRE(sb.size() == 2);
+    }
+}
+
+TEST_CASE("inplace_stringbuilder.EncodeRadix", "[inplace_stringbuilder]")
+{
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << hex(0) << ' ' << hex(255) << ' ' << hex<4, true>(255) << ' ' << hex<0, false, true>(0x1234) << ' ' << hex<6, true, true>(0xBEEF);
+        REQUIRE(sb.str() == "0 ff 00FF 0x1234 0X00BEEF");
+    }
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << hex(int8_t{-1}) << ' ' << hex(-1) << ' ' << hex(std::numeric_limits<uint64_t>::max());
+        REQUIRE(sb.str() == "ff ffffffff ffffffffffffffff");
+    }
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << oct(8) << ' ' << oct<0, true>(8) << ' ' << oct<4>(7) << ' ' << oct(std::numeric_limits<uint64_t>::max());
+        REQUIRE(sb.str() == "10 010 0007 1777777777777777777777");
+    }
+    {   // The octal prefix is not doubled by a leading zero digit, as with "%#o" of printf().
+        auto sb = inplace_stringbuilder<64>{};
+        sb << oct<0, true>(0) << ' ' << oct<4, true>(8) << ' ' << oct<2, true>(8) << ' ' << hex<0, false, true>(0);
+        REQUIRE(sb.str() == "0 0010 010 0x0");
+    }
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << bin(0) << ' ' << bin(5) << ' ' << bin<8>(5) << ' ' << bin<0, true>(uint8_t{0x80});
+        REQUIRE(sb.str() == "0 101 00000101 0b10000000");
+    }
+    {   auto sb = inplace_stringbuilder<5, false>{};
+        sb << hex<4>(0xab) << '=';
+        REQUIRE(sb.str() == "=00ab");
+    }
+    {   auto sb = inplace_stringbuilder<4, true, std::char_traits<char>, inplace_stringbuilder_overflow_polcy::protect>{};
+        sb << hex<0, false, true>(0xabcd);
+        REQUIRE(sb.str() == "0xab");
+    }
+}
+
+TEST_CASE("inplace_stringbuilder.EncodePadded", "[inplace_stringbuilder]")
+{
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << padded<6>(42) << ' ' << padded<6>(-42) << ' ' << padded<6, ' '>(-42) << ' ' << padded<6, '*'>(42);
+        REQUIRE(sb.str() == "000042 -00042    -42 ****42");
+    }
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << padded<2>(7) << ':' << padded<2>(45) << ':' << padded<1>(0) << '.' << padded<3>(9) << ' ' << padded<4, ' '>(1234) << ' ' << padded<2, ' '>(-7);
+        REQUIRE(sb.str() == "07:45:0.009 1234 -7");
+    }
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << padded<20>(std::numeric_limits<uint64_t>::max()) << ' ' << padded<20>(std::numeric_limits<int64_t>::min()) << ' ' << padded<5>(int8_t{-128});
+        REQUIRE(sb.str() == "18446744073709551615 -9223372036854775808 -0128");
+    }
+    {   auto sb = inplace_stringbuilder<8, false>{};
+        sb << padded<3>(5) << '-' << padded<4>(12);
+        REQUIRE(sb.str() == "0012-005");
+    }
+}
+
+TEST_CASE("inplace_stringbuilder.EncodeGrouped", "[inplace_stringbuilder]")
+{
+    static_assert(grouped_int_t<int32_t, char>::max_size == 14, "");
+    static_assert(grouped_int_t<uint64_t, char>::max_size == 26, "");
+    static_assert(grouped_int_t<int8_t, char>::max_size == 4, "");
+
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << grouped(0) << ' ' << grouped(999) << ' ' << grouped(-1000) << ' ' << grouped(1234567) << ' ' << grouped(-12345, ' ');
+        REQUIRE(sb.str() == "0 999 -1,000 1,234,567 -12 345");
+    }
+    {   auto sb = inplace_stringbuilder<grouped_int_t<int64_t, char>::max_size + grouped_int_t<uint64_t, char>::max_size + 1>{};
+        sb << grouped(std::numeric_limits<int64_t>::min(), '.') << ' ' << grouped(std::numeric_limits<uint64_t>::max(), '\'');
+        REQUIRE(sb.str() == "-9.223.372.036.854.775.808 18'446'744'073'709'551'615");
+    }
+    {   auto sb = inplace_stringbuilder<12, false>{};
+        sb << grouped(100200300u) << '=';
+        REQUIRE(sb.str() == "=100,200,300");
+    }
+}
+
 TEST_CASE("inplace_stringbuilder.EncodeOther", "[inplace_stringbuilder]")
 {
     {   auto sb = inplace_stringbuilder<11, false>{};
         sb << -123.4567;
-        REQUIRE(std::to_string(sb) == "-123.456700");
+        REQUIRE(std::to_string(sb) == "-123.4567");
+    }
+}
+
+TEST_CASE("inplace_stringbuilder.EncodeDouble", "[inplace_stringbuilder]")
+{
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << 0.0 << ' ' << -0.0 << ' ' << 1.0 << ' ' << 0.1 << ' ' << 0.3 << ' ' << 2.0 / 3 << ' ' << 1500.0 << ' ' << 0.015;
+        REQUIRE(sb.str() == "0 -0 1 0.1 0.3 0.6666666666666666 1500 0.015");
+    }
+    {   auto sb = inplace_stringbuilder<128>{};
+        sb << 1e20 << ' ' << 1e16 << ' ' << 123456.0 << ' ' << 0.001 << ' ' << 0.0001 << ' ' << 1.5e-7 << ' ' << 1e100 << ' ' << 9007199254740993.0;
+        REQUIRE(sb.str() == "1e+20 1e+16 123456 0.001 1e-04 1.5e-07 1e+100 9007199254740992");
+    }
+    {   // Integers beyond 2^53 show their exact digits in the fixed notation, like std::to_chars() does.
+        auto sb = inplace_stringbuilder<64>{};
+        sb << 1152921504606846976.0 << ' ' << -18446744073709551616.0;
+        REQUIRE(sb.str() == "1152921504606846976 -18446744073709551616");
+    }
+    {   auto sb = inplace_stringbuilder<128>{};
+        sb << std::numeric_limits<double>::max() << ' ' << -std::numeric_limits<double>::min() << ' ' << std::numeric_limits<double>::denorm_min();
+        REQUIRE(sb.str() == "1.7976931348623157e+308 -2.2250738585072014e-308 5e-324");
+    }
+    {   auto sb = inplace_stringbuilder<32>{};
+        sb << std::numeric_limits<double>::infinity() << ' ' << -std::numeric_limits<double>::infinity() << ' ' << std::numeric_limits<double>::quiet_NaN();
+        REQUIRE(sb.str() == "inf -inf nan");
+    }
+    {   auto sb = inplace_stringbuilder<4, true, std::char_traits<char>, inplace_stringbuilder_overflow_polcy::protect>{};
+        sb << 3.14159;
+        REQUIRE(sb.str() == "3.14");
     }
 }
 
+TEST_CASE("inplace_stringbuilder.EncodeFloat", "[inplace_stringbuilder]")
+{
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << 0.1f << ' ' << 1.0f / 3 << ' ' << -0.0f << ' ' << 16777216.0f << ' ' << 1.5e-7f << ' ' << 2.5e10f;
+        REQUIRE(sb.str() == "0.1 0.33333334 -0 16777216 1.5e-07 2.5e+10");
+    }
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << 73761776.0f << ' ' << 1099511627776.0f;
+        REQUIRE(sb.str() == "73761776 1099511627776");
+    }
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << std::numeric_limits<float>::max() << ' ' << -std::numeric_limits<float>::min() << ' ' << std::numeric_limits<float>::denorm_min() << ' ' << std::numeric_limits<float>::infinity();
+        REQUIRE(sb.str() == "3.4028235e+38 -1.1754944e-38 1e-45 inf");
+    }
+}
+
+TEST_CASE("inplace_stringbuilder.EncodeHexfloat", "[inplace_stringbuilder]")
+{
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << hexfloat(3.0) << ' ' << hexfloat(1.0) << ' ' << hexfloat(-0.0) << ' ' << hexfloat(0.1) << ' ' << hexfloat<true>(0.1f);
+        REQUIRE(sb.str() == "0x1.8p+1 0x1p+0 -0x0p+0 0x1.999999999999ap-4 0X1.99999AP-4");
+    }
+    {   constexpr size_t maxSize = hexfloat_t<double, false>::max_size;
+        auto sb = inplace_stringbuilder<maxSize>{};
+        sb << hexfloat(std::numeric_limits<double>::denorm_min() - std::numeric_limits<double>::min());
+        REQUIRE(sb.str() == "-0x0.fffffffffffffp-1022");
+        REQUIRE(sb.size() == maxSize);
+    }
+    {   auto sb = inplace_stringbuilder<64>{};
+        sb << hexfloat(std::numeric_limits<double>::denorm_min()) << ' ' << hexfloat(std::numeric_limits<double>::max()) << ' ' << hexfloat<true>(-std::numeric_limits<double>::infinity());
+        REQUIRE(sb.str() == "0x0.0000000000001p-1022 0x1.fffffffffffffp+1023 -INF");
+    }
+    {   // A float is widened to double, so its subnormals come out normalized, as printf("%a") shows a float argument.
+        auto sb = inplace_stringbuilder<64>{};
+        sb << hexfloat(std::numeric_limits<float>::denorm_min()) << ' ' << hexfloat(std::numeric_limits<float>::min() / 3);
+        REQUIRE(sb.str() == "0x1p-149 0x1.555558p-128");
+    }
+}
+
+TEST_CASE("inplace_stringbuilder.EncodeFixedAndScientific", "[inplace_stringbuilder]")
+{
+    {   auto sb = inplace_stringbuilder<128>{};
+        sb << fixed<3>(2.0 / 3) << ' ' << fixed<2>(-0.004) << ' ' << fixed<0>(2.5) << ' ' << fixed<0>(3.5) << ' ' << fixed<2>(1.005) << ' ' << fixed<1>(0.25f) << ' ' << fixed<4>(1e6);
+        REQUIRE(sb.str() == "0.667 -0.00 2 4 1.00 0.2 1000000.0000");
+    }
+    {   auto sb = inplace_stringbuilder<128>{};
+        sb << sci<3>(123456.0) << ' ' << sci<2>(9.996) << ' ' << sci<0>(-0.00015) << ' ' << sci<1>(0.0) << ' ' << sci<3>(5e-324) << ' ' << sci<4>(1.7976931348623157e308);
+        REQUIRE(sb.str() == "1.235e+05 1.00e+01 -1e-04 0.0e+00 4.941e-324 1.7977e+308");
+    }
+    {   constexpr size_t maxSize = fixed_float_t<2, double>::max_size;
+        auto sb = inplace_stringbuilder<maxSize>{};
+        sb << fixed<2>(-std::numeric_limits<double>::max());
+        REQUIRE(sb.size() == maxSize);
+        REQUIRE(sb.str().substr(0, 8) == "-1797693");
+        REQUIRE(sb.str().substr(maxSize - 6) == "368.00");
+    }
+    {   auto sb = inplace_stringbuilder<32>{};
+        sb << fixed<2>(std::numeric_limits<double>::infinity()) << ' ' << sci<2>(-std::numeric_limits<float>::infinity());
+        REQUIRE(sb.str() == "inf -inf");
+    }
+}
+
+TEST_CASE("inplace_stringbuilder.AppendAndAssignTo", "[inplace_stringbuilder]")
+{
+    auto target = std::string(100, 'x');
+    const auto* const targetData = target.data();
+
+    auto sb = inplace_stringbuilder<16>{};
+    sb << "There are " << 10;
+    sb.assign_to(target);
+    REQUIRE(target == "There are 10");
+    sb.append_to(target);
+    REQUIRE(target == "There are 10There are 10");
+
+    auto rsb = inplace_stringbuilder<16, false>{};
+    rsb << "01" << "23";
+    rsb.assign_to(target);
+    REQUIRE(target == "2301");
+    REQUIRE(target.data() == targetData);
+}
+
 TEST_CASE("inplace_stringbuilder.ostream", "[inplace_stringbuilder]")
 {
     auto sb = inplace_stringbuilder<17>{};
@@ -114,6 +361,142 @@ TEST_CASE("stringbuilder.Reserve", "[stringbuilder]")
     REQUIRE(std::to_string(sb) == "abcdxyzw");
 }
 
+TEST_CASE("stringbuilder.Claim", "[stringbuilder]")
+{
+    auto sb = stringbuilder<4>{};
+    sb << "abc";
+    std::char_traits<char>::copy(sb.claim(5), "01234", 5);
+    REQUIRE(std::to_string(sb) == "abc01234");
+
+    const auto claimed = sb.claim(2, 10);
+    REQUIRE(claimed.second >= 2);
+    REQUIRE(claimed.second <= 10);
+    std::char_traits<char>::copy(claimed.first, "xy", 2);
+    sb.reclaim(claimed.second - 2);
+    sb << 'z';
+    REQUIRE(std::to_string(sb) == "abc01234xyz");
+    REQUIRE(sb.size() == 11);
+}
+
+TEST_CASE("stringbuilder.Size", "[stringbuilder]")
+{
+    auto sb = stringbuilder<4>{};
+    REQUIRE(sb.size() == 0);
+    size_t expectedSize = 0;
+    for (int i = 0; i < 1000; ++i) {
+        sb << i << ' ';
+        expectedSize += std::to_string(i).size() + 1;
+        REQUIRE(sb.size() == expectedSize);
+    }
+    sb.reserve(5000);
+    sb.append(4000, 'x');
+    sb.claim(300);
+    sb.reclaim(300);
+    REQUIRE(sb.size() == expectedSize + 4000);
+    REQUIRE(sb.str().size() == sb.size());
+}
+
+TEST_CASE("stringbuilder.EncodeInteger", "[stringbuilder]")
+{
+    auto sb = stringbuilder<3>{};
+    sb << 12 << ' ' << -4567 << ' ' << std::numeric_limits<int64_t>::min() << ' ' << std::numeric_limits<uint64_t>::max();
+    REQUIRE(std::to_string(sb) == "12 -4567 -9223372036854775808 18446744073709551615");
+}
+
+TEST_CASE("stringbuilder.EncodeRadix", "[stringbuilder]")
+{
+    auto sb = stringbuilder<3>{};
+    sb << hex<0, false, true>(0xdeadbeefu) << ' ' << hex<16, true>(uint64_t{0x1234}) << ' ' << oct(0755) << ' ' << bin(10);
+    REQUIRE(std::to_string(sb) == "0xdeadbeef 0000000000001234 755 1010");
+
+    auto wsb = wstringbuilder<>{};
+    wsb << hex<2, true>(10);
+    REQUIRE(wsb.str() == L"0A");
+}
+
+TEST_CASE("stringbuilder.EncodeGrouped", "[stringbuilder]")
+{
+    auto sb = stringbuilder<4>{};
+    sb << grouped(int16_t{-32768}) << ' ' << grouped(uint64_t{1000000000000});
+    REQUIRE(std::to_string(sb) == "-32,768 1,000,000,000,000");
+
+    auto wsb = wstringbuilder<>{};
+    wsb << grouped(9876543, L' ');
+    REQUIRE(wsb.str() == L"9 876 543");
+}
+
+#ifdef STRINGBUILDER_SUPPORTS_INT128
+TEST_CASE("stringbuilder.EncodeInt128", "[stringbuilder]")
+{
+    __extension__ using int128 = __int128;
+    __extension__ using uint128 = unsigned __int128;
+    const auto int128Max = static_cast<int128>(~uint128{} >> 1);
+
+    auto sb = stringbuilder<8>{};
+    sb << -int128Max - 1 << ' ' << ~uint128{} << ' ' << int128{0} << ' ' << static_cast<uint128>(UINT64_MAX) + 1;
+    REQUIRE(std::to_string(sb) == "-170141183460469231731687303715884105728 340282366920938463463374607431768211455 0 18446744073709551616");
+
+    uint128 v = 1;
+    for (int i = 0; i < 38; ++i) v *= 10;
+    auto ipsb = inplace_stringbuilder<160>{};
+    ipsb << v - 1 << ' ' << v << ' ' << hex(~uint128{}) << ' ' << padded<24>(-int128{1000000000000000000} * 100);
+    REQUIRE(std::to_string(ipsb) == "99999999999999999999999999999999999999 100000000000000000000000000000000000000 ffffffffffffffffffffffffffffffff -00100000000000000000000");
+}
+#endif
+
+TEST_CASE("stringbuilder.AppendRange", "[stringbuilder]")
+{
+    const std::vector<int32_t> values{ 0, -1, 42, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max() };
+    {   auto sb = stringbuilder<4>{};
+        sb << '[';
+        sb.append_range(values.begin(), values.end(), ", ");
+        sb << ']';
+        REQUIRE(std::to_string(sb) == "[0, -1, 42, -2147483648, 2147483647]");
+    }
+    {   auto sb = stringbuilder<>{};
+        sb.append_range(values.begin(), values.begin(), ',');
+        sb.append_range(values.begin() + 2, values.begin() + 3, ',');
+        const uint64_t column[] = { 18446744073709551615ull, 10, 9 };
+        sb.append_range(std::begin(column), std::end(column), '\t');
+        REQUIRE(std::to_string(sb) == "4218446744073709551615\t10\t9");
+    }
+    {   auto sb = stringbuilder<>{};
+        const std::vector<std::string> words{ "alpha", "beta" };
+        sb.append_range(words.begin(), words.end(), " | ");
+        REQUIRE(std::to_string(sb) == "alpha | beta");
+    }
+    {   auto wsb = wstringbuilder<>{};
+        wsb.append_range(values.begin(), values.begin() + 3, L';');
+        REQUIRE(wsb.str() == L"0;-1;42");
+    }
+    {   std::vector<int64_t> probes;
+        for (uint64_t v = 1, i = 0; i < 19; v *= 10, ++i) {
+            for (const uint64_t probe : { v - 1, v, v + 1, 2 * v - 1 }) {
+                probes.push_back(static_cast<int64_t>(probe));
+                probes.push_back(-static_cast<int64_t>(probe));
+            }
+        }
+        probes.push_back(std::numeric_limits<int64_t>::min());
+        // Enough values to span several batches and chunks.
+        std::vector<int64_t> range;
+        auto expected = stringbuilder<>{};
+        for (size_t i = 0; i < 1000; ++i) {
+            range.push_back(probes[i % probes.size()]);
+            expected << (i > 0 ? " " : "") << range.back();
+        }
+        auto sb = stringbuilder<>{};
+        sb.append_range(range.begin(), range.end(), ' ');
+        REQUIRE(std::to_string(sb) == std::to_string(expected));
+    }
+}
+
+TEST_CASE("stringbuilder.IntegralConstant", "[stringbuilder]")
+{
+    auto sb = stringbuilder<>{};
+    sb << std::integral_constant<int, -12>{} << ' ' << std::integral_constant<char, 'x'>{};
+    REQUIRE(std::to_string(sb) == "-12 x");
+}
+
 TEST_CASE("stringbuilder.AppendCharMulti", "[stringbuilder]")
 {
     auto sb = stringbuilder<5>{};
@@ -133,6 +516,575 @@ TEST_CASE("stringbuilder.AppendStringBuilder", "[stringbuilder]")
     REQUIRE(std::to_string(sb) == "123 123 123 123 123 123 123 123 ");
 }
 
+template<typename T>
+struct CountingAllocator {
+    using value_type = T;
+
+    CountingAllocator() = default;
+    template<typename U> CountingAllocator(const CountingAllocator<U>&) noexcept {}
+
+    T* allocate(size_t n) { ++liveCount(); return std::allocator<T>{}.allocate(n); }
+    void deallocate(T* p, size_t n) { --liveCount(); std::allocator<T>{}.deallocate(p, n); }
+
+    static int& liveCount() { static int count = 0; return count; }
+
+    template<typename U> bool operator==(const CountingAllocator<U>&) const noexcept { return true; }
+    template<typename U> bool operator!=(const CountingAllocator<U>&) const noexcept { return false; }
+};
+
+TEST_CASE("stringbuilder.ClearAndReset", "[stringbuilder]")
+{
+    using counting_stringbuilder = basic_stringbuilder<char, 8, std::char_traits<char>, CountingAllocator<char>>;
+    const int& liveCount = CountingAllocator<uint8_t>::liveCount();
+    {
+        auto sb = counting_stringbuilder{};
+        for (int i = 0; i < 100; ++i) {
+            sb << "0123456789";
+        }
+        const int chunkCount = liveCount;
+        REQUIRE(chunkCount > 1);
+
+        sb.clear();
+        REQUIRE(sb.size() == 0);
+        REQUIRE(sb.str().empty());
+        sb << "There are " << 8 << " bits in a single byte.";
+        sb.append(1000 - 34, 'y');
+        REQUIRE(sb.size() == 1000);
+        REQUIRE(sb.str().substr(0, 40) == "There are 8 bits in a single byte.yyyyyy");
+        REQUIRE(liveCount == chunkCount);
+
+        sb.reset(1000);
+        REQUIRE(sb.size() == 0);
+        REQUIRE(liveCount > 0);
+        REQUIRE(liveCount < chunkCount);
+
+        sb.reset();
+        REQUIRE(liveCount == 0);
+        sb << "abc";
+        REQUIRE(sb.str() == "abc");
+        sb.append(100, 'z');
+        REQUIRE(sb.size() == 103);
+    }
+    REQUIRE(liveCount == 0);
+}
+
+TEST_CASE("stringbuilder.PooledAllocator", "[stringbuilder]")
+{
+    {   auto alloc = pooled_allocator<uint8_t, 1024, 512>{};
+        uint8_t* const block = alloc.allocate(100);
+        alloc.deallocate(block, 100);
+        REQUIRE(alloc.allocate(128) == block);      // The same size class of 128 bytes.
+        uint8_t* const other = alloc.allocate(100);
+        REQUIRE(other != block);
+        alloc.deallocate(other, 100);
+        alloc.deallocate(block, 128);
+        REQUIRE(alloc.allocate(65) == block);       // Most recently released first.
+        alloc.deallocate(block, 65);
+    }
+    {   auto makeRiddle = []() {
+            auto sb = pooled_stringbuilder<8>{};
+            for (int i = 0; i < 20; ++i) {
+                sb << "There are " << 8 << " bits in a single byte.\n";
+            }
+            REQUIRE(sb.size() == 20 * 35);
+            return sb.str();
+        };
+        const auto riddle = makeRiddle();
+        REQUIRE(makeRiddle() == riddle);
+    }
+}
+
+TEST_CASE("stringbuilder.GrowthPolicy", "[stringbuilder]")
+{
+    const int& liveCount = CountingAllocator<uint8_t>::liveCount();
+    const std::string piece(100, '.');
+    const std::string expected = [&]() { std::string s; for (int i = 0; i < 100; ++i) s += piece; return s; }();
+
+    {   auto sb = stringbuilder<8, std::char_traits<char>, CountingAllocator<char>, hinted_growth>{};
+        sb.growth_policy().expect(expected.size());
+        for (int i = 0; i < 100; ++i) {
+            sb << piece;
+        }
+        REQUIRE(liveCount == 1);
+        REQUIRE(sb.str() == expected);
+    }
+    {   auto sb = stringbuilder<8, std::char_traits<char>, CountingAllocator<char>, page_growth<4096>>{};
+        for (int i = 0; i < 100; ++i) {
+            sb << piece;
+        }
+        REQUIRE(liveCount == 3);    // Each page holds 40 pieces.
+        REQUIRE(sb.str() == expected);
+    }
+    {   auto sb = stringbuilder<8, std::char_traits<char>, CountingAllocator<char>, geometric_growth<2, 1, 256>>{};
+        for (int i = 0; i < 100; ++i) {
+            sb << piece;
+        }
+        REQUIRE(liveCount == 51);   // The first chunk holds 1 piece, the next ones are capped to 296 characters, 2 pieces each.
+        REQUIRE(sb.str() == expected);
+    }
+    REQUIRE(liveCount == 0);
+}
+
+TEST_CASE("stringbuilder.HugePageAllocator", "[stringbuilder]")
+{
+    {   auto alloc = huge_page_allocator<uint8_t, 4096>{};
+        for (const size_t size : { size_t{100}, size_t{4096}, size_t{3 * 1024 * 1024} }) {
+            uint8_t* const block = alloc.allocate(size);
+            std::fill(block, block + size, uint8_t{0xA5});
+            REQUIRE(block[size - 1] == 0xA5);
+            alloc.deallocate(block, size);
+        }
+    }
+    {   auto sb = stringbuilder<0, std::char_traits<char>, huge_page_allocator<char, 64 * 1024>>{};
+        auto expected = std::string{};
+        for (int i = 0; i < 100000; ++i) {
+            sb << i << ' ';
+            expected += std::to_string(i) + ' ';
+        }
+        REQUIRE(sb.str() == expected);
+    }
+}
+
+TEST_CASE("stringbuilder.WideChunks", "[stringbuilder]")
+{
+    auto sb = wstringbuilder<4>{};
+    auto expected = std::wstring{};
+    for (int i = 0; i < 1000; ++i) {
+        sb << L"wide " << i << L' ';
+        expected += L"wide " + std::to_wstring(i) + L' ';
+    }
+    REQUIRE(sb.size() == expected.size());
+    REQUIRE(sb.str() == expected);
+}
+
+TEST_CASE("stringbuilder.ExternalBuffer", "[stringbuilder]")
+{
+    using counting_stringbuilder = basic_stringbuilder<char, 4, std::char_traits<char>, CountingAllocator<char>>;
+    const int& liveCount = CountingAllocator<uint8_t>::liveCount();
+    char buffer[256];
+    {
+        auto sb = counting_stringbuilder{buffer + 1, sizeof(buffer) - 1};
+        sb << "Built " << "in " << "the " << "caller's " << "buffer.";
+        REQUIRE(sb.str() == "Built in the caller's buffer.");
+        REQUIRE(liveCount == 0);
+        REQUIRE(std::search(std::begin(buffer), std::end(buffer), "buffer.", "buffer." + 7) != std::end(buffer));
+
+        auto expected = sb.str();
+        for (int i = 0; i < 100; ++i) {
+            sb << ' ' << i;
+            expected += ' ' + std::to_string(i);
+        }
+        REQUIRE(liveCount > 0);
+        REQUIRE(sb.str() == expected);
+
+        sb.reset();
+        REQUIRE(liveCount == 0);
+        sb << "Reused after reset().";
+        REQUIRE(sb.str() == "Reused after reset().");
+        REQUIRE(liveCount == 0);
+
+        auto moved = std::move(sb);
+        moved << " Moved.";
+        REQUIRE(moved.str() == "Reused after reset(). Moved.");
+        REQUIRE(liveCount == 0);
+        REQUIRE(sb.size() == 0);
+
+        auto other = counting_stringbuilder{};
+        other << "The buffer goes along.";
+        other.swap(moved);
+        REQUIRE(other.str() == "Reused after reset(). Moved.");
+        REQUIRE(moved.str() == "The buffer goes along.");
+        other.append(200, '+');
+        REQUIRE(other.size() == 228);
+
+        moved = std::move(other);
+        REQUIRE(moved.size() == 228);
+    }
+    REQUIRE(liveCount == 0);
+
+    {
+        // The buffer is too small for the bookkeeping, so it is not used at all.
+        auto sb = counting_stringbuilder{buffer, 4};
+        sb << "Spilled to the heap.";
+        REQUIRE(sb.str() == "Spilled to the heap.");
+        REQUIRE(liveCount > 0);
+    }
+    REQUIRE(liveCount == 0);
+}
+
+TEST_CASE("stringbuilder.MoveConstruct", "[stringbuilder]")
+{
+    // The tail chunk is the in-place head.
+    auto a = stringbuilder<16>{};
+    a << "abc";
+    auto b = std::move(a);
+    b << "def";
+    REQUIRE(b.str() == "abcdef");
+    REQUIRE(a.size() == 0);
+    a << "ghi";
+    REQUIRE(a.str() == "ghi");
+    REQUIRE(b.str() == "abcdef");
+
+    // The tail chunk is on the heap.
+    auto expected = std::string{};
+    for (int i = 0; i < 20; ++i) {
+        b << i;
+        expected += std::to_string(i);
+    }
+    auto c = std::move(b);
+    c << '!';
+    REQUIRE(c.str() == "abcdef" + expected + '!');
+    REQUIRE(c.size() == 7 + expected.size());
+    REQUIRE(b.size() == 0);
+    REQUIRE(b.str().empty());
+    b << "reused";
+    REQUIRE(b.str() == "reused");
+}
+
+TEST_CASE("stringbuilder.MoveAssign", "[stringbuilder]")
+{
+    using counting_stringbuilder = basic_stringbuilder<char, 8, std::char_traits<char>, CountingAllocator<char>>;
+    const int& liveCount = CountingAllocator<uint8_t>::liveCount();
+    {
+        auto a = counting_stringbuilder{};
+        auto b = counting_stringbuilder{};
+        a << "short";
+        b << "This one does not fit in place.";
+        const int chunkCount = liveCount;
+        REQUIRE(chunkCount > 0);
+
+        b = std::move(a);
+        REQUIRE(liveCount == 0);
+        REQUIRE(b.str() == "short");
+        REQUIRE(a.size() == 0);
+
+        a << "This one does not fit in place.";
+        b = std::move(a);
+        REQUIRE(liveCount == chunkCount);
+        b << "..";
+        REQUIRE(b.str() == "This one does not fit in place...");
+        REQUIRE(a.str().empty());
+
+        auto& self = b;
+        b = std::move(self);
+        REQUIRE(b.str() == "This one does not fit in place...");
+    }
+    REQUIRE(liveCount == 0);
+}
+
+template<typename T>
+struct TaggedAllocator
+{
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::false_type;
+
+    explicit TaggedAllocator(int tag) noexcept : tag{tag} {}
+    template<typename U> TaggedAllocator(const TaggedAllocator<U>& other) noexcept : tag{other.tag} {}
+
+    T* allocate(size_t n) { return std::allocator<T>{}.allocate(n); }
+    void deallocate(T* p, size_t n) { std::allocator<T>{}.deallocate(p, n); }
+
+    template<typename U> bool operator==(const TaggedAllocator<U>& other) const noexcept { return tag == other.tag; }
+    template<typename U> bool operator!=(const TaggedAllocator<U>& other) const noexcept { return tag != other.tag; }
+
+    int tag;
+};
+
+TEST_CASE("stringbuilder.MoveAssignUnequalAllocators", "[stringbuilder]")
+{
+    using tagged_stringbuilder = basic_stringbuilder<char, 4, std::char_traits<char>, TaggedAllocator<char>>;
+    // Copying the content allocates, so the move assignment may throw, unlike with an allocator whose instances are all equal.
+    static_assert(!std::is_nothrow_move_assignable<tagged_stringbuilder>::value, "");
+    static_assert(std::is_nothrow_move_assignable<stringbuilder<4>>::value, "");
+    auto a = tagged_stringbuilder{TaggedAllocator<char>{1}};
+    auto b = tagged_stringbuilder{TaggedAllocator<char>{2}};
+    a << "Chunks of another allocator are copied.";
+    b << "old";
+    b = std::move(a);
+    REQUIRE(b.str() == "Chunks of another allocator are copied.");
+    REQUIRE(b.get_allocator().tag == 2);
+    REQUIRE(a.size() == 0);
+}
+
+#ifdef STRINGBUILDER_SUPPORTS_PMR
+struct CountingResource : std::pmr::memory_resource
+{
+    int allocations = 0;
+    int deallocations = 0;
+
+    void* do_allocate(size_t bytes, size_t alignment) override { ++allocations; return std::pmr::new_delete_resource()->allocate(bytes, alignment); }
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override { ++deallocations; std::pmr::new_delete_resource()->deallocate(p, bytes, alignment); }
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+};
+
+TEST_CASE("stringbuilder.PolymorphicAllocator", "[stringbuilder]")
+{
+    auto resource = CountingResource{};
+    {
+        auto sb = pmr::stringbuilder<4>{&resource};
+        for (int i = 0; i < 100; ++i) {
+            sb << "pmr " << i << ' ';
+        }
+        REQUIRE(sb.get_allocator().resource() == &resource);
+        REQUIRE(resource.allocations > 1);
+        REQUIRE(sb.str().substr(0, 16) == "pmr 0 pmr 1 pmr ");
+
+        auto moved = std::move(sb);
+        REQUIRE(moved.get_allocator().resource() == &resource);
+        REQUIRE(moved.size() == 690);
+
+        auto otherResource = CountingResource{};
+        auto other = pmr::stringbuilder<4>{&otherResource};
+        other = std::move(moved);
+        REQUIRE(other.get_allocator().resource() == &otherResource);
+        REQUIRE(other.size() == 690);
+        REQUIRE(resource.deallocations == resource.allocations);
+        REQUIRE(otherResource.allocations > 0);
+    }
+    REQUIRE(resource.deallocations == resource.allocations);
+}
+
+TEST_CASE("stringbuilder.ArenaAllocator", "[stringbuilder]")
+{
+    auto resource = CountingResource{};
+    {
+        auto arena = std::pmr::monotonic_buffer_resource{&resource};
+        {
+            auto sb = pmr::arena_stringbuilder<>{&arena};
+            for (int i = 0; i < 1000; ++i) {
+                sb << "arena " << i << ' ';
+            }
+            REQUIRE(sb.size() == 9890);
+            REQUIRE(sb.str().substr(0, 24) == "arena 0 arena 1 arena 2 ");
+            sb.reset();
+            sb << "again";
+            REQUIRE(sb.str() == "again");
+        }
+        REQUIRE(resource.allocations > 0);
+        REQUIRE(resource.deallocations == 0);
+    }
+    REQUIRE(resource.deallocations == resource.allocations);
+}
+#endif
+
+TEST_CASE("stringbuilder.Swap", "[stringbuilder]")
+{
+    auto a = stringbuilder<8>{};
+    auto b = stringbuilder<8>{};
+    a << "in place";
+    b << "on the heap, " << 12345;
+    a.swap(b);
+    REQUIRE(a.str() == "on the heap, 12345");
+    REQUIRE(b.str() == "in place");
+    a << '.';
+    b << '!';
+    REQUIRE(a.str() == "on the heap, 12345.");
+    REQUIRE(b.str() == "in place!");
+
+    swap(a, b);
+    REQUIRE(a.str() == "in place!");
+    REQUIRE(b.str() == "on the heap, 12345.");
+
+    auto c = stringbuilder<8>{};
+    c << "abc";
+    swap(a, c);
+    REQUIRE(a.str() == "abc");
+    REQUIRE(c.str() == "in place!");
+    a << "def";
+    c << "ghi";
+    REQUIRE(a.str() == "abcdef");
+    REQUIRE(c.str() == "in place!ghi");
+}
+
+TEST_CASE("stringbuilder.VectorOfBuilders", "[stringbuilder]")
+{
+    auto builders = std::vector<stringbuilder<8>>{};
+    for (int i = 0; i < 100; ++i) {
+        builders.emplace_back();
+        builders.back() << "builder #" << i;
+        if (i % 2 == 0)
+            builders[i / 2] << ',' << i;
+    }
+    std::reverse(builders.begin(), builders.end());
+    for (int i = 0; i < 100; ++i) {
+        const int index = 99 - i;
+        auto expected = "builder #" + std::to_string(index);
+        if (index < 50)
+            expected += ',' + std::to_string(2 * index);
+        REQUIRE(builders[i].str() == expected);
+    }
+}
+
+TEST_CASE("stringbuilder.ForEachChunk", "[stringbuilder]")
+{
+    auto sb = stringbuilder<4>{};
+    auto expected = std::string{};
+    for (int i = 0; i < 1000; ++i) {
+        sb << i << ',';
+        expected += std::to_string(i) + ',';
+    }
+
+    auto visited = std::string{};
+    size_t chunkCount = 0;
+    sb.for_each_chunk([&](const char* data, size_t size) {
+        REQUIRE(size > 0);
+        visited.append(data, size);
+        ++chunkCount;
+    });
+    REQUIRE(visited == expected);
+    REQUIRE(chunkCount > 3);
+
+    sb.clear();
+    chunkCount = 0;
+    sb.for_each_chunk([&](const char*, size_t) { ++chunkCount; });
+    REQUIRE(chunkCount == 0);
+}
+
+TEST_CASE("stringbuilder.AppendAndAssignTo", "[stringbuilder]")
+{
+    auto sb = stringbuilder<4>{};
+    auto expected = std::string{};
+    for (int i = 0; i < 1000; ++i) {
+        sb << i << ',';
+        expected += std::to_string(i) + ',';
+    }
+
+    auto target = std::string{"prefix:"};
+    sb.append_to(target);
+    REQUIRE(target == "prefix:" + expected);
+
+    // The capacity of the target is reused, so assigning shorter or equal content does not reallocate.
+    const auto* const targetData = target.data();
+    sb.assign_to(target);
+    REQUIRE(target == expected);
+    sb.clear();
+    sb << "short";
+    sb.assign_to(target);
+    REQUIRE(target == "short");
+    REQUIRE(target.data() == targetData);
+
+    sb.clear();
+    sb.assign_to(target);
+    REQUIRE(target.empty());
+
+    auto wide = wstringbuilder<2>{};
+    wide << L"wide" << L" string";
+    auto wideTarget = std::wstring{L">"};
+    wide.append_to(wideTarget);
+    REQUIRE(wideTarget == L">wide string");
+}
+
+#ifdef STRINGBUILDER_SUPPORTS_IOVEC
+TEST_CASE("stringbuilder.ToIovec", "[stringbuilder]")
+{
+    auto sb = stringbuilder<4>{};
+    auto expected = std::string{};
+    for (int i = 0; i < 1000; ++i) {
+        sb << i << ',';
+        expected += std::to_string(i) + ',';
+    }
+
+    // Few iovec structures at a time, as if the chunks were more than IOV_MAX.
+    struct iovec iov[3];
+    auto exported = std::string{};
+    auto position = stringbuilder<4>::chunk_position{};
+    size_t callCount = 0;
+    while (!position.at_end()) {
+        const size_t filled = sb.to_iovec(iov, 3, position);
+        for (size_t i = 0; i < filled; ++i) {
+            REQUIRE(iov[i].iov_len > 0);
+            exported.append(static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+        }
+        ++callCount;
+    }
+    REQUIRE(exported == expected);
+    REQUIRE(callCount > 1);
+    REQUIRE(sb.to_iovec(iov, 3, position) == 0);
+
+    // Empty chunks (the in-place one, and one skipped by a claim which does not fit in it) are left out.
+    auto sparse = stringbuilder<0>{};
+    sparse.reserve(10);
+    std::fill_n(sparse.claim(500), 500, 'x');
+    auto sparsePosition = stringbuilder<0>::chunk_position{};
+    REQUIRE(sparse.to_iovec(iov, 3, sparsePosition) == 1);
+    REQUIRE(iov[0].iov_len == 500);
+    REQUIRE(sparsePosition.at_end());
+
+    auto wide = wstringbuilder<>{};
+    wide << L"wide";
+    auto widePosition = wstringbuilder<>::chunk_position{};
+    REQUIRE(wide.to_iovec(iov, 3, widePosition) == 1);
+    REQUIRE(iov[0].iov_len == 4 * sizeof(wchar_t));
+}
+
+static std::string readAvailable(int fd)
+{
+    auto received = std::string{};
+    char buffer[4096];
+    ssize_t n;
+    while ((n = ::read(fd, buffer, sizeof(buffer))) > 0) {
+        received.append(buffer, static_cast<size_t>(n));
+    }
+    return received;
+}
+
+TEST_CASE("stringbuilder.WriteTo", "[stringbuilder]")
+{
+    int fds[2];
+    REQUIRE(::pipe(fds) == 0);
+    REQUIRE(::fcntl(fds[0], F_SETFL, O_NONBLOCK) == 0);
+    REQUIRE(::fcntl(fds[1], F_SETFL, O_NONBLOCK) == 0);
+
+    // Small chunks, more of them than a single writev() takes, and more content than the pipe holds at once.
+    auto sb = stringbuilder<4, std::char_traits<char>, std::allocator<char>, page_growth<64>>{};
+    auto expected = std::string{};
+    for (int i = 0; i < 50000; ++i) {
+        sb << i << ',';
+        expected += std::to_string(i) + ',';
+    }
+
+    // The consuming write leaves in the builder exactly what the pipe did not take.
+    auto received = std::string{};
+    while (true) {
+        try {
+            sb.write_to(fds[1], true);
+            break;
+        }
+        catch (const std::system_error& e) {
+            REQUIRE(e.code() == std::errc::resource_unavailable_try_again);
+        }
+        received += readAvailable(fds[0]);
+        REQUIRE(sb.size() + received.size() == expected.size());
+    }
+    received += readAvailable(fds[0]);
+    REQUIRE(received == expected);
+    REQUIRE(sb.size() == 0);
+
+    // The builder is usable after consumption, and a non-consuming write keeps the content.
+    sb << "after";
+    sb.write_to(fds[1]);
+    sb.write_to(fds[1]);
+    REQUIRE(readAvailable(fds[0]) == "afterafter");
+    REQUIRE(sb.str() == "after");
+
+    REQUIRE_THROWS_AS(sb.write_to(-1, true), std::system_error);
+    REQUIRE(sb.str() == "after");
+
+    auto isb = inplace_stringbuilder<16>{};
+    isb << "in" << "place";
+    isb.write_to(fds[1], true);
+    REQUIRE(isb.size() == 0);
+    auto risb = inplace_stringbuilder<16, false>{};
+    risb << "in" << "place";
+    risb.write_to(fds[1]);
+    REQUIRE(readAvailable(fds[0]) == "inplaceplacein");
+    REQUIRE(risb.str() == "placein");
+
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+#endif
+
 TEST_CASE("stringbuilder.ostream", "[stringbuilder]")
 {
     auto sb = stringbuilder<23>{};
@@ -179,6 +1131,78 @@ TEST_CASE("make_string.SizedStr", "[make_string]")
     REQUIRE(make_string("There", ' ', "are ", 8, " bits in a ", "single ", sized_str<4>(std::string{ "byte" }), '.') == std::string{"There are 8 bits in a single byte."});
 }
 
+TEST_CASE("make_string.Radix", "[make_string]")
+{
+    REQUIRE(make_string("addr=", hex<0, false, true>(0x7fff0010u), " mode=", oct<4>(0644)) == std::string{"addr=0x7fff0010 mode=0644"});
+}
+
+TEST_CASE("make_string.Padded", "[make_string]")
+{
+    REQUIRE(make_string(padded<4>(2020), '-', padded<2>(3), '-', padded<2>(7), " #", padded<8, ' '>(-15)) == std::string{"2020-03-07 #     -15"});
+}
+
+TEST_CASE("make_string.EstimateTypeSize", "[make_string]")
+{
+    using namespace STRINGBUILDER_NAMESPACE::detail;
+    static_assert(estimateTypeSize<char>(type<int8_t>{}) == 4, "");
+    static_assert(estimateTypeSize<char>(type<uint8_t>{}) == 3, "");
+    static_assert(estimateTypeSize<char>(type<int16_t>{}) == 6, "");
+    static_assert(estimateTypeSize<char>(type<uint16_t>{}) == 5, "");
+    static_assert(estimateTypeSize<char>(type<int32_t>{}) == 11, "");
+    static_assert(estimateTypeSize<char>(type<uint32_t>{}) == 10, "");
+    static_assert(estimateTypeSize<char>(type<int64_t>{}) == 20, "");
+    static_assert(estimateTypeSize<char>(type<uint64_t>{}) == 20, "");
+    static_assert(estimateTypeSize<char>(type<bool>{}) == 1, "");
+#ifdef STRINGBUILDER_SUPPORTS_INT128
+    static_assert(estimateTypeSize<char>(type<Int128>{}) == 40, "");
+    static_assert(estimateTypeSize<char>(type<UInt128>{}) == 39, "");
+#endif
+    static_assert(estimateTypeSize<char>(type<hex_t<uint16_t, 0, false, true>>{}) == 6, "");
+    static_assert(estimateTypeSize<char>(type<oct_t<int8_t>>{}) == 3, "");
+    static_assert(estimateTypeSize<char>(type<padded_int_t<7, '0', int64_t>>{}) == 7, "");
+    static_assert(estimateTypeSize<char>(type<grouped_int_t<int32_t, char>>{}) == 14, "");
+    static_assert(estimateTypeSize<char>(type<double>{}) == 24, "");
+    static_assert(estimateTypeSize<char>(type<float>{}) == 15, "");
+    static_assert(estimateTypeSize<char>(type<fixed_float_t<3, float>>{}) == 44, "");
+    static_assert(estimateTypeSize<char>(type<sci_float_t<6, double>>{}) == 14, "");
+    static_assert(estimateTypeSize<char>(type<hexfloat_t<double, false>>{}) == 24, "");
+    static_assert(estimateTypeSize<char>(type<hexfloat_t<float, true>>{}) == 16, "");
+    static_assert(estimateTypeSeqSize<char>(type<EstimatedType<const int16_t&>>{}, type<EstimatedType<const char(&)[4]>>{}, type<EstimatedType<char&>>{}) == 10, "");
+
+    const int8_t i8 = -128;
+    const uint16_t u16 = 65535;
+    const auto sizedStr = sized_str<3>(std::string{"abc"});
+    REQUIRE(make_string("i8=", i8, " u16=", u16, ' ', sizedStr) == std::string{"i8=-128 u16=65535 abc"});
+    REQUIRE(make_stringbuilder(i8, ' ', u16).str() == std::string{"-128 65535"});
+}
+
+TEST_CASE("make_string.Constexpr_Integers", "[make_string]")
+{
+    {   constexpr auto s = make_string("error ", std::integral_constant<int, 404>{}, ": ", std::integral_constant<int64_t, -9223372036854775807 - 1>{}, '!');
+        static_assert(s.size() == 32, "");
+        REQUIRE(s.c_str() == std::string{"error 404: -9223372036854775808!"});
+    }
+    {   constexpr auto s = make_string(std::integral_constant<unsigned, 0>{}, ' ', std::integral_constant<uint64_t, 18446744073709551615ull>{});
+        REQUIRE(s.c_str() == std::string{"0 18446744073709551615"});
+    }
+#if __cpp_nontype_template_parameter_auto
+    {   constexpr auto s = make_string("code=", num<-7>, " max=", num<99u>);
+        REQUIRE(s.c_str() == std::string{"code=-7 max=99"});
+    }
+#endif
+    {   const int runtime = 5;
+        REQUIRE(make_string(std::integral_constant<int, 10>{}, '/', runtime) == std::string{"10/5"});
+    }
+    {   // A compile-time character is the character itself, the same as when appended at run time.
+        constexpr auto s = make_string(std::integral_constant<char, 'x'>{}, 'y', std::integral_constant<signed char, 7>{});
+        static_assert(s.size() == 3, "");
+        REQUIRE(s.c_str() == std::string{"xy7"});
+        auto sb = stringbuilder<>{};
+        sb << std::integral_constant<char, 'x'>{} << 'y' << std::integral_constant<signed char, 7>{};
+        REQUIRE(sb.str() == s.c_str());
+    }
+}
+
 TEST_CASE("make_string.Constexpr_Simple", "[make_string]")
 {
     {   constexpr auto s = make_string('a', "bcd", 'x');